@@ -0,0 +1,264 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** EcsBenchmark
+*/
+#include <benchmark/benchmark.h>
+#include "ecs/EntityManager.hpp"
+#include "systems/MouvementSystem.hpp"
+#include "physics/Broadphase.hpp"
+#include "physics/Narrowphase.hpp"
+#include "physics/TileMap.hpp"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Micro-benchmarks of the shared ECS
+ *
+ * @details Every benchmark runs on worlds of 1k, 10k and 100k entities. Run with
+ * --benchmark_out=<file> --benchmark_out_format=json (or the ecs-bench-report target)
+ * to keep the results of a release and compare the next one against them.
+ */
+namespace {
+    using namespace rtype;
+
+    constexpr std::size_t WALLS = 8;
+
+    /**
+     * @brief Fills a world like a crowded level: projectiles, enemies, players and bare movers
+     * @details Enemies drift vertically so they stay on screen and the world keeps the same
+     * size across iterations.
+     */
+    void populate(EntityManager& manager, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            EntityID entity = manager.createEntity();
+            manager.addComponent(entity, Position{static_cast<float>(i % 780), static_cast<float>(i * 7 % 580)});
+            switch (i % 4) {
+                case 0:
+                    manager.addComponent(entity, Velocity{300.0f, 0.0f});
+                    manager.addComponent(entity, Projectile{1.0f, 0, true, false});
+                    break;
+                case 1:
+                    manager.addComponent(entity, Velocity{0.0f, (i % 8 == 1) ? 20.0f : -20.0f});
+                    manager.addComponent(entity, Enemy{5, 3.0f, 1, 100.0f, false});
+                    break;
+                case 2:
+                    manager.addComponent(entity, Velocity{40.0f, -40.0f});
+                    manager.addComponent(entity, Player{0, 3, 1});
+                    break;
+                default:
+                    manager.addComponent(entity, Velocity{-10.0f, 10.0f});
+                    break;
+            }
+        }
+        for (std::size_t i = 0; i < WALLS; ++i) {
+            EntityID wall = manager.createEntity();
+            manager.addComponent(wall, Position{100.0f + 80.0f * i, 250.0f});
+            manager.addComponent(wall, Velocity{0.0f, 0.0f});
+            manager.addComponent(wall, Wall{});
+        }
+    }
+
+    void BM_CreateDestroyChurn(benchmark::State& state) {
+        EntityManager manager;
+        populate(manager, state.range(0));
+        std::vector<EntityID> ids = manager.getEntitiesWithComponents<Position>();
+        std::size_t next = 0;
+
+        for (auto _ : state) {
+            manager.destroyEntity(ids[next]);
+            EntityID entity = manager.createEntity();
+            manager.addComponent(entity, Position{1.0f, 1.0f});
+            manager.addComponent(entity, Velocity{1.0f, 1.0f});
+            ids[next] = entity;
+            next = (next + 1) % ids.size();
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_AddRemoveComponent(benchmark::State& state) {
+        EntityManager manager;
+        populate(manager, state.range(0));
+        std::vector<EntityID> ids = manager.getEntitiesWithComponents<Position, Player>();
+        std::size_t next = 0;
+
+        for (auto _ : state) {
+            manager.addComponent(ids[next], HealthBonus{3});
+            manager.removeComponent<HealthBonus>(ids[next]);
+            next = (next + 1) % ids.size();
+        }
+        state.SetItemsProcessed(state.iterations() * 2);
+    }
+
+    void BM_HasComponent(benchmark::State& state) {
+        EntityManager manager;
+        populate(manager, state.range(0));
+        const EntityID count = state.range(0) + WALLS;
+
+        for (auto _ : state) {
+            std::size_t enemies = 0;
+            for (EntityID entity = 0; entity < count; ++entity)
+                enemies += manager.hasComponent<Enemy>(entity);
+            benchmark::DoNotOptimize(enemies);
+        }
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+
+    void BM_HasTag(benchmark::State& state) {
+        EntityManager manager;
+        populate(manager, state.range(0));
+        const EntityID count = state.range(0) + WALLS;
+        const TagSet& walls = manager.tagged<Wall>();
+
+        for (auto _ : state) {
+            std::size_t found = 0;
+            for (EntityID entity = 0; entity < count; ++entity)
+                found += walls.test(entity);
+            benchmark::DoNotOptimize(found);
+        }
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+
+    void BM_GetEntitiesWithComponents(benchmark::State& state) {
+        EntityManager manager;
+        populate(manager, state.range(0));
+
+        for (auto _ : state) {
+            auto enemies = manager.getEntitiesWithComponents<Position, Enemy>();
+            benchmark::DoNotOptimize(enemies.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0) / 4);
+    }
+
+    void BM_GetEntitiesWithComponentsReused(benchmark::State& state) {
+        EntityManager manager;
+        populate(manager, state.range(0));
+        std::vector<EntityID> enemies;
+
+        for (auto _ : state) {
+            manager.getEntitiesWithComponents<Position, Enemy>(enemies);
+            benchmark::DoNotOptimize(enemies.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0) / 4);
+    }
+
+    void BM_ViewEach(benchmark::State& state) {
+        EntityManager manager;
+        populate(manager, state.range(0));
+        auto movers = manager.view<const Position, const Velocity>();
+
+        for (auto _ : state) {
+            float sum = 0;
+            movers.each([&sum](EntityID, const Position& pos, const Velocity& vel) {
+                sum += pos.x * vel.dx;
+            });
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    /**
+     * @brief Loads level pillars where populate puts its walls
+     */
+    physics::TileMap pillars() {
+        physics::TileMap tiles;
+        std::array<physics::TileChunk, 3> chunks{};
+        for (std::size_t i = 0; i < WALLS; ++i) {
+            const std::size_t column = static_cast<std::size_t>((100.0f + 80.0f * i) / physics::TILE_SIZE);
+            chunks[column / physics::CHUNK_COLUMNS].columns[column % physics::CHUNK_COLUMNS] = 0b111u << 12;
+        }
+        for (std::uint32_t index = 0; index < chunks.size(); ++index) {
+            chunks[index].index = index;
+            tiles.load(chunks[index]);
+        }
+        return tiles;
+    }
+
+    void BM_MovementSystem(benchmark::State& state) {
+        EntityManager manager;
+        populate(manager, state.range(0));
+        const physics::TileMap tiles = pillars();
+        MovementSystem movement(&tiles);
+
+        for (auto _ : state) {
+            movement.update(manager, 1.0f / 60.0f);
+            movement.flush(manager);
+            manager.advanceTick();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_CollisionPairs(benchmark::State& state) {
+        EntityManager manager;
+        populate(manager, state.range(0));
+        const std::uint32_t layers[] = {LAYER_PLAYER_SHOT, LAYER_ENEMY, LAYER_PLAYER, LAYER_ENEMY_SHOT};
+        physics::UniformGrid grid;
+        const physics::CollisionMatrix matrix = physics::CollisionMatrix::standard();
+        std::vector<physics::CollisionPair> pairs;
+
+        for (auto _ : state) {
+            grid.clear();
+            manager.view<const Position>().each([&](EntityID entity, const Position& pos) {
+                const std::uint32_t layer = manager.hasComponent<Wall>(entity) ? LAYER_WALL : layers[entity % 4];
+                grid.insert(entity, layer, {pos.x - 5.0f, pos.y - 5.0f, pos.x + 5.0f, pos.y + 5.0f});
+            });
+            grid.build();
+            grid.collectPairs(matrix, pairs);
+            benchmark::DoNotOptimize(pairs.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_CircleHitsCircles(benchmark::State& state) {
+        physics::CircleSet circles;
+        for (std::int64_t i = 0; i < state.range(0); ++i)
+            circles.push({static_cast<float>(i % 780), static_cast<float>(i * 7 % 580)}, 5.0f);
+        std::vector<std::uint64_t> hits(physics::maskWords(circles.size()));
+
+        for (auto _ : state) {
+            physics::circleHitsCircles({400.0f, 300.0f}, 20.0f, circles, hits.data());
+            benchmark::DoNotOptimize(hits.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_SaveSnapshot(benchmark::State& state) {
+        EntityManager manager;
+        populate(manager, state.range(0));
+        std::vector<std::uint8_t> snapshot;
+
+        for (auto _ : state) {
+            manager.saveSnapshot(snapshot);
+            benchmark::DoNotOptimize(snapshot.data());
+        }
+        state.SetBytesProcessed(state.iterations() * snapshot.size());
+    }
+
+    void BM_LoadSnapshot(benchmark::State& state) {
+        EntityManager manager;
+        populate(manager, state.range(0));
+        std::vector<std::uint8_t> snapshot;
+        manager.saveSnapshot(snapshot);
+
+        for (auto _ : state)
+            manager.loadSnapshot(snapshot);
+        state.SetBytesProcessed(state.iterations() * snapshot.size());
+    }
+}
+
+BENCHMARK(BM_CreateDestroyChurn)->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK(BM_AddRemoveComponent)->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK(BM_HasComponent)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_HasTag)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_GetEntitiesWithComponents)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_GetEntitiesWithComponentsReused)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ViewEach)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MovementSystem)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_CollisionPairs)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_CircleHitsCircles)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SaveSnapshot)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LoadSnapshot)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
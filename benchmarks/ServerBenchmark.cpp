@@ -0,0 +1,135 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** ServerBenchmark
+*/
+#include "game/GameEngine.hpp"
+#include "network/HeadlessNetworkManager.hpp"
+#include "systems/TickClock.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Headless benchmark of a whole game room
+ *
+ * @details Runs GameEngine::update back to back, without sleeping, with simulated players sending
+ * scripted inputs, until they finish the third level or the tick limit is reached. Packets go to a
+ * sink that only counts them and the database lives in memory. Reports the ticks per second, the
+ * tick time percentiles and the allocations per tick, to size the hardware needed per room.
+ * The scripted session can be recorded, to be replayed with r-type_server --replay.
+ *
+ * Usage: r-type-server-bench [players] [max ticks] [tick rate] [session log]
+ */
+namespace {
+    std::atomic<std::uint64_t> allocations{0};
+
+    std::vector<uint8_t> inputPacket(bool up, bool down, bool left) {
+        using namespace rtype::network;
+        std::vector<uint8_t> packet(sizeof(PacketHeader) + sizeof(PlayerInputPacket));
+        auto* header = reinterpret_cast<PacketHeader*>(packet.data());
+        auto* input = reinterpret_cast<PlayerInputPacket*>(packet.data() + sizeof(PacketHeader));
+
+        header->magic[0] = 'R';
+        header->magic[1] = 'T';
+        header->version = 1;
+        header->type = static_cast<uint8_t>(PacketType::PLAYER_INPUT);
+        header->length = packet.size();
+        header->sequence = 0;
+        *input = PlayerInputPacket{up, down, left, false, true, true};
+        return packet;
+    }
+
+    /**
+     * @brief Gets a percentile of sorted samples, by nearest rank
+     */
+    double percentile(const std::vector<double>& sorted, double rank) {
+        if (sorted.empty())
+            return 0.0;
+        const auto index = static_cast<std::size_t>(rank * static_cast<double>(sorted.size() - 1) + 0.5);
+        return sorted[std::min(index, sorted.size() - 1)];
+    }
+}
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size == 0 ? 1 : size))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+int main(int argc, char** argv) {
+    const int players = argc > 1 ? std::atoi(argv[1]) : 4;
+    const std::uint32_t maxTicks = argc > 2 ? static_cast<std::uint32_t>(std::atol(argv[2])) : 60 * 60 * 20;
+    const int tickRate = argc > 3 ? std::atoi(argv[3]) : rtype::DEFAULT_TICK_RATE;
+    if (players <= 0 || maxTicks == 0 || tickRate <= 0) {
+        std::fprintf(stderr, "Usage: %s [players] [max ticks] [tick rate] [session log]\n", argv[0]);
+        return 1;
+    }
+    const float dt = 1.0f / static_cast<float>(tickRate);
+
+    rtype::network::HeadlessNetworkManager network;
+    rtype::game::GameEngine engine(network, tickRate, ":memory:");
+    std::unique_ptr<rtype::game::SessionRecorder> recorder;
+    if (argc > 4) {
+        recorder = std::make_unique<rtype::game::SessionRecorder>(argv[4], engine.seed(), tickRate);
+        engine.setRecorder(recorder.get());
+    }
+    std::vector<asio::ip::udp::endpoint> endpoints;
+    for (int i = 0; i < players; ++i) {
+        endpoints.emplace_back(asio::ip::make_address_v4("10.0.0.1"), static_cast<unsigned short>(20000 + i));
+        engine.createNewPlayer(endpoints.back());
+    }
+    // Players go to the left edge, then sweep the screen up and down while shooting
+    const std::vector<uint8_t> goLeft = inputPacket(false, false, true);
+    const std::vector<uint8_t> goUp = inputPacket(true, false, false);
+    const std::vector<uint8_t> goDown = inputPacket(false, true, false);
+    const std::uint32_t sweepTicks = static_cast<std::uint32_t>(tickRate) * 3;
+
+    std::vector<double> tickTimes;
+    tickTimes.reserve(maxTicks);
+    const std::uint64_t allocationsBefore = allocations.load();
+    const auto start = std::chrono::steady_clock::now();
+    std::uint32_t tick = 0;
+
+    while (tick < maxTicks && engine.level() <= 3) {
+        ++tick;
+        const auto tickStart = std::chrono::steady_clock::now();
+        for (int i = 0; i < players; ++i) {
+            const std::uint32_t phase = (tick + static_cast<std::uint32_t>(i) * sweepTicks / static_cast<std::uint32_t>(players)) % (2 * sweepTicks);
+            const std::vector<uint8_t>& input = tick < 2u * static_cast<std::uint32_t>(tickRate) ? goLeft : (phase < sweepTicks ? goUp : goDown);
+            engine.handleMessage(input, endpoints[i]);
+        }
+        engine.update(tick, dt);
+        tickTimes.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - tickStart).count());
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const std::uint64_t allocated = allocations.load() - allocationsBefore;
+    std::sort(tickTimes.begin(), tickTimes.end());
+
+    std::printf("players: %d, tick rate: %d, ticks: %u (%.1f s simulated)\n", players, tickRate, tick, tick * dt);
+    std::printf("level reached: %d%s\n", std::min(engine.level(), 3), engine.level() > 3 ? " (game completed)" : " (tick limit reached)");
+    std::printf("ticks per second: %.0f (%.1fx real time)\n", tick / seconds, tick * dt / seconds);
+    std::printf("tick time: p50 %.1f us, p99 %.1f us, max %.1f us\n", percentile(tickTimes, 0.50), percentile(tickTimes, 0.99),
+        tickTimes.empty() ? 0.0 : tickTimes.back());
+    std::printf("allocations per tick: %.2f\n", static_cast<double>(allocated) / tick);
+    std::printf("packets per tick: %.1f (%.0f bytes)\n", static_cast<double>(network.packets) / tick, static_cast<double>(network.bytes) / tick);
+    return engine.level() > 3 ? 0 : 2;
+}
@@ -27,7 +27,10 @@ namespace rtype {
     }
 
     /**
-     * @brief Handles an incoming network message and dispatches it to the appropriate packet handler.
+     * @brief Queues an incoming network message until the main thread processes it.
+     *
+     * Called on the network thread, which must not touch the entities: the systems read them
+     * on the main thread and the scheduler workers at the same time.
      *
      * @param data   The raw packet data received from the server.
      * @param sender The endpoint (IP and port) of the server.
@@ -36,6 +39,52 @@ namespace rtype {
                                     [[maybe_unused]] const asio::ip::udp::endpoint& sender)
     {
         if (data.size() < sizeof(network::PacketHeader)) return;
+        std::lock_guard<std::mutex> lock(packetMutex);
+        pendingPackets.push_back(data);
+    }
+
+    /**
+     * @brief Dispatches the messages received since the last call to their packet handlers, on the main thread.
+     */
+    void Game::processNetworkMessages() {
+        {
+            std::lock_guard<std::mutex> lock(packetMutex);
+            pendingPackets.swap(receivedPackets);
+        }
+        for (const auto& data : receivedPackets)
+            dispatchPacket(data);
+        receivedPackets.clear();
+    }
+
+    /**
+     * @brief Tells the server the client is still there, even when the player sends no input.
+     *
+     * @param now The time of the current frame.
+     */
+    void Game::sendHeartbeat(std::chrono::steady_clock::time_point now) {
+        if (!network || currentState == GameState::MENU)
+            return;
+        if (std::chrono::duration<float>(now - lastHeartbeat).count() < network::HEARTBEAT_INTERVAL)
+            return;
+        lastHeartbeat = now;
+        std::vector<uint8_t> packet(sizeof(network::PacketHeader));
+        auto* header = reinterpret_cast<network::PacketHeader*>(packet.data());
+        header->magic[0] = 'R';
+        header->magic[1] = 'T';
+        header->version = 1;
+        header->type = static_cast<uint8_t>(network::PacketType::HEARTBEAT);
+        header->length = packet.size();
+        header->sequence = 0;
+        network->sendTo(packet);
+    }
+
+    /**
+     * @brief Dispatches a network message to the appropriate packet handler.
+     *
+     * @param data The raw packet data received from the server.
+     */
+    void Game::dispatchPacket(const std::vector<uint8_t>& data)
+    {
 
         const auto* header = reinterpret_cast<const network::PacketHeader*>(data.data());
         auto type = static_cast<network::PacketType>(header->type);
@@ -60,6 +109,9 @@ namespace rtype {
         const auto* entityUpdate = reinterpret_cast<const network::EntityUpdatePacket*>(data.data() + offset);
         EntityID entity = entityUpdate->entityId;
 
+        if (!syncGeneration(entity, entityUpdate->generation))
+            return;
+
         // Update player stats if this is our player
         if (entityUpdate->type == 0 && entity == myPlayerId)
         {
@@ -158,12 +210,6 @@ namespace rtype {
                         setupEnemyRenderComponent(entity, entityUpdate->type, renderComp);
                         break;
                     }
-                case 7:
-                    {
-                        // Wall
-                        setupWallRenderComponent(entity, renderComp);
-                        break;
-                    }
                 case 8:
                     {
                         // Boss
@@ -179,6 +225,9 @@ namespace rtype {
                     }
                 }
                 entities.addComponent(entity, renderComp);
+                // Dropped by the DespawnSystem if the server removal is lost
+                if (entityUpdate->type != 0)
+                    entities.addComponent(entity, Bounds{});
             }
             else
             {
@@ -311,24 +360,6 @@ namespace rtype {
         renderComp.sprite.setOrigin(renderComp.frameWidth / 2.0f, renderComp.frameHeight / 2.0f);
     }
 
-    /**
-  * @brief Configures the rendering for a wall entity.
-  *
-  * @param entity     The wall entity ID.
-  * @param renderComp Reference to the RenderComponent to update.
-  */
-    void Game::setupWallRenderComponent(EntityID entity, RenderComponent& renderComp)
-    {
-        entities.addComponent(entity, Wall{3});
-        renderComp.sprite.setTexture(*ResourceManager::getInstance().getTexture("wall"));
-        renderComp.sprite.setTextureRect(sf::IntRect(0, 0, 167, 587));
-        renderComp.sprite.setOrigin(10.0f, 8.0f);
-        renderComp.frameWidth = 165;
-        renderComp.frameHeight = 590;
-        renderComp.frameCount = 1;
-        renderComp.sprite.setScale(0.1f, 0.1f);
-    }
-
     /**
      * @brief Updates an existing entity (e.g., convert Enemy to Projectile).
      *
@@ -339,8 +370,7 @@ namespace rtype {
      */
     void Game::updateExistingEntity(EntityID entity, const network::EntityUpdatePacket* entityUpdate) {
         if (entityUpdate->type == 1 && entities.hasComponent<Enemy>(entity)) {
-            entities.getComponents<Enemy>().erase(entity);
-            entities.getComponents<Position>().erase(entity);
+            entities.removeComponent<Enemy>(entity);
             RenderComponent renderComp = entities.getComponent<RenderComponent>(entity);
             entities.addComponent(entity, Projectile{10.0f, true, false, false});
             renderComp.sprite.setTexture(*ResourceManager::getInstance().getTexture("sheet"));
@@ -382,26 +412,89 @@ namespace rtype {
         if (playerLife <= 0)
             playerIsDead = true;
 
-        if (response->entityId != static_cast<uint32_t>(-1))
+        if (response->entityId != static_cast<uint32_t>(-1) && syncGeneration(response->entityId, response->generation))
         {
-            if (entities.hasComponent<Enemy>(response->entityId))
-                entities.getComponents<Enemy>().erase(response->entityId);
-            if (entities.hasComponent<Player>(response->entityId))
-                entities.getComponents<Player>().erase(response->entityId);
-            if (entities.hasComponent<Position>(response->entityId))
-                entities.getComponents<Position>().erase(response->entityId);
-            if (entities.hasComponent<Velocity>(response->entityId))
-                entities.getComponents<Velocity>().erase(response->entityId);
             entities.destroyEntity(response->entityId);
+            serverGenerations[response->entityId] = response->generation + 1;
         }
 
-        if (response->entityId2 != static_cast<uint32_t>(-1))
+        if (response->entityId2 != static_cast<uint32_t>(-1) && syncGeneration(response->entityId2, response->generation2))
         {
-            entities.getComponents<Projectile>().erase(response->entityId2);
             entities.destroyEntity(response->entityId2);
+            serverGenerations[response->entityId2] = response->generation2 + 1;
+        }
+    }
+
+    /**
+     * @brief Handles the entities the server removed during a tick without them dying.
+     *
+     * @param data   The raw packet data.
+     * @param offset The offset where the EntityDespawnPacket begins.
+     */
+    void Game::handleEntityDespawn(const std::vector<uint8_t>& data, size_t offset) {
+        if (data.size() < offset + sizeof(network::EntityDespawnPacket))
+            return;
+        const auto* despawn = reinterpret_cast<const network::EntityDespawnPacket*>(data.data() + offset);
+        const auto* entries = reinterpret_cast<const network::DespawnEntry*>(data.data() + offset + sizeof(network::EntityDespawnPacket));
+        const std::size_t count = std::min<std::size_t>(despawn->count,
+            (data.size() - offset - sizeof(network::EntityDespawnPacket)) / sizeof(network::DespawnEntry));
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (syncGeneration(entries[i].entityId, entries[i].generation))
+            {
+                entities.destroyEntity(entries[i].entityId);
+                serverGenerations[entries[i].entityId] = entries[i].generation + 1;
+            }
         }
     }
 
+    /**
+     * @brief Loads a chunk of the level geometry and catches up with the scroll of the server.
+     *
+     * @param data   The raw packet data.
+     * @param offset The offset where the TileChunkPacket begins.
+     */
+    void Game::handleTileChunk(const std::vector<uint8_t>& data, size_t offset) {
+        if (data.size() < offset + sizeof(network::TileChunkPacket))
+            return;
+        const auto* packet = reinterpret_cast<const network::TileChunkPacket*>(data.data() + offset);
+        physics::TileChunk chunk;
+        chunk.index = packet->index;
+        for (std::size_t i = 0; i < chunk.columns.size(); ++i)
+            chunk.columns[i] = packet->columns[i];
+        tileMap.load(chunk);
+        tileMap.setScroll(packet->scroll);
+    }
+
+    /**
+     * @brief Checks the generation of a server entity ID against the one mirrored locally.
+     *
+     * UDP packets can arrive late: an update or a death carrying an older generation is about
+     * an entity the client already destroyed and is dropped. A newer generation means the server
+     * destroyed the entity and reused its ID, so the stale local entity is removed first.
+     *
+     * IDs past MAX_ENTITIES come from a malformed packet, and the packet is ignored.
+     *
+     * @param entity     The server entity ID.
+     * @param generation The generation carried by the packet.
+     * @return bool False if the packet must be ignored.
+     */
+    bool Game::syncGeneration(EntityID entity, EntityGeneration generation) {
+        if (entity >= MAX_ENTITIES)
+            return false;
+        if (entity >= serverGenerations.size())
+            serverGenerations.resize(entity + 1, 0);
+        EntityGeneration& known = serverGenerations[entity];
+        if (generation < known)
+            return false;
+        if (generation > known) {
+            entities.destroyEntity(entity);
+            known = generation;
+        }
+        return true;
+    }
+
     /**
      * @brief Initializes all packet handlers used for incoming server messages.
      */
@@ -412,6 +505,12 @@ namespace rtype {
         packetHandlers[network::PacketType::ENTITY_DEATH] =
             [this](const auto& data, size_t offset) { handleEntityDeath(data, offset); };
 
+        packetHandlers[network::PacketType::ENTITY_DESPAWN] =
+            [this](const auto& data, size_t offset) { handleEntityDespawn(data, offset); };
+
+        packetHandlers[network::PacketType::TILE_CHUNK] =
+            [this](const auto& data, size_t offset) { handleTileChunk(data, offset); };
+
         packetHandlers[network::PacketType::ENTITY_UPDATE] =
             [this](const auto& data, size_t offset) { handleEntityUpdate(data, offset); };
 
@@ -496,33 +595,16 @@ namespace rtype {
                 }
             }
             window.clear();
-            if (menu.getColorblindMode())
-            {
-                auto& bgComponents = entities.getComponents<BackgroundComponent>();
-
-                for (EntityID entity = 0; entity < MAX_ENTITIES; ++entity)
-                {
-                    if (bgComponents[entity].has_value() && bgComponents[entity]->layer == 0)
-                    {
-                        auto& bgComp = bgComponents[entity].value();
-                        bgComp.sprite.setTexture(*ResourceManager::getInstance().getTexture("bg-colorblind"));
-                        break;
-                    }
-                }
-            }
-            else
+            const std::string bgTexture = menu.getColorblindMode() ? "bg-colorblind" : "bg-blue";
+            bool bgUpdated = false;
+            entities.forEach<BackgroundComponent>([&](EntityID, BackgroundComponent& bgComp)
             {
-                auto& bgComponents = entities.getComponents<BackgroundComponent>();
-                for (EntityID entity = 0; entity < MAX_ENTITIES; ++entity)
+                if (!bgUpdated && bgComp.layer == 0)
                 {
-                    if (bgComponents[entity].has_value() && bgComponents[entity]->layer == 0)
-                    {
-                        auto& bgComp = bgComponents[entity].value();
-                        bgComp.sprite.setTexture(*ResourceManager::getInstance().getTexture("bg-blue"));
-                        break;
-                    }
+                    bgComp.sprite.setTexture(*ResourceManager::getInstance().getTexture(bgTexture));
+                    bgUpdated = true;
                 }
-            }
+            });
             update();
             for (auto& system : systems)
             {
@@ -576,6 +658,7 @@ namespace rtype {
                 auto startTime = std::chrono::steady_clock::now();
                 while (!myPlayerId && currentState == GameState::CONNECTING)
                 {
+                    processNetworkMessages();
                     auto currentTime = std::chrono::steady_clock::now();
                     if (std::chrono::duration_cast<std::chrono::seconds>(currentTime - startTime).count() > 5)
                     {
@@ -777,10 +860,9 @@ namespace rtype {
         auto currentTime = std::chrono::steady_clock::now();
         float dt = std::chrono::duration<float>(currentTime - lastUpdate).count();
         lastUpdate = currentTime;
-        if (currentState == GameState::PLAYING)
-        {
-            cleanupEntities();
-        }
+        // Packets are applied between frames, never while the systems run
+        processNetworkMessages();
+        sendHeartbeat(currentTime);
         switch (currentState)
         {
         case GameState::MENU:
@@ -794,19 +876,19 @@ namespace rtype {
             }
             break;
         case GameState::PLAYING:
-            for (size_t i = 0; i < systems.size(); ++i)
+            // The level keeps scrolling between the chunks of the server
+            tileMap.scrollBy(physics::LEVEL_SCROLL_SPEED * dt);
+            tileMap.unloadBefore(tileMap.firstVisibleChunk());
+            try
             {
-                try
-                {
-                    systems[i]->update(entities, dt);
-                }
-                catch (const std::exception& e)
-                {
-                    std::cerr << "Exception in system " << i << ": " << e.what() << std::endl;
-                } catch (...)
-                {
-                    std::cerr << "Unknown exception in system " << i << std::endl;
-                }
+                scheduler.run(systems, entities, dt);
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "Exception in systems: " << e.what() << std::endl;
+            } catch (...)
+            {
+                std::cerr << "Unknown exception in systems" << std::endl;
             }
             break;
         case GameState::GAME_OVER:
@@ -890,6 +972,10 @@ namespace rtype {
         std::string serverIP = menu.getServerIP();
         uint16_t serverPort = menu.getServerPort();
         network = std::make_unique<network::NetworkClient>(serverIP, serverPort);
+        {
+            std::lock_guard<std::mutex> lock(packetMutex);
+            pendingPackets.clear();
+        }
         network->setMessageCallback([this](const std::vector<uint8_t>& data, const asio::ip::udp::endpoint& sender)
         {
             handleNetworkMessage(data, sender);
@@ -948,8 +1034,10 @@ namespace rtype {
      */
     void Game::setupSystems() {
         systems.push_back(std::make_unique<BackgroundSystem>(window));
-        systems.push_back(std::make_unique<MovementSystem>());
+        systems.push_back(std::make_unique<MovementSystem>(&tileMap));
+        systems.push_back(std::make_unique<DespawnSystem>());
         systems.push_back(std::make_unique<AnimationSystem>());
+        systems.push_back(std::make_unique<TileRenderSystem>(window, tileMap));
         systems.push_back(std::make_unique<RenderSystem>(window));
     }
 
@@ -1062,33 +1150,6 @@ namespace rtype {
         }
     }
 
-    /**
-     * @brief Periodically removes entities that have gone out of bounds.
-     *
-     * Prevents infinite growth of ECS data structures by cleaning up useless entities.
-     */
-    void Game::cleanupEntities() {
-        static auto lastCleanup = std::chrono::steady_clock::now();
-        auto now = std::chrono::steady_clock::now();
-        if (std::chrono::duration_cast<std::chrono::seconds>(now - lastCleanup).count() >= 1)
-        {
-            lastCleanup = now;
-            auto positions = entities.getEntitiesWithComponents<Position>();
-            for (EntityID entity : positions)
-            {
-                const auto& pos = entities.getComponent<Position>(entity);
-                if (pos.x < -100 || pos.x > 900 || pos.y < -100 || pos.y > 700)
-                {
-                    if (entity != myPlayerId)
-                    {
-                        // Ne pas supprimer le joueur
-                        entities.destroyEntity(entity);
-                    }
-                }
-            }
-        }
-    }
-
     /**
      * @brief Processes leaderboard data received from the server and enters LEADERBOARD state.
      *
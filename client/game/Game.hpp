@@ -10,6 +10,10 @@
 #include "shared/ecs/EntityManager.hpp"
 #include "shared/systems/System.hpp"
 #include "shared/systems/MouvementSystem.hpp"
+#include "shared/systems/DespawnSystem.hpp"
+#include "shared/physics/TileMap.hpp"
+#include "systems/TileRenderSystem.hpp"
+#include "shared/systems/Scheduler.hpp"
 #include "network/NetworkManager.hpp"
 #include <systems/RenderSystem.hpp>
 #include "shared/network/packetType.hpp"
@@ -25,6 +29,7 @@
 #include <memory>
 #include <iostream>
 #include <thread>
+#include <mutex>
 
 namespace rtype {
 
@@ -127,19 +132,18 @@ namespace rtype {
         sf::RenderWindow window;                               ///< Main SFML window for rendering.
         EntityManager entities;                                 ///< ECS EntityManager to handle all entities.
         std::vector<std::unique_ptr<ISystem>> systems;         ///< List of all systems (e.g., rendering, movement).
+        Scheduler scheduler;                                   ///< Runs the systems in parallel when their accesses allow it.
+        std::vector<EntityGeneration> serverGenerations;       ///< Generation of each server entity ID mirrored locally.
+        physics::TileMap tileMap;                               ///< Level geometry streamed by the server, scrolled locally between its packets.
 
         // =========================
         // == Networking         ==
         // =========================
 
         std::unique_ptr<network::NetworkClient> network; ///< Manages UDP communication with the server.
-
-        /**
-         * @brief Cleans up out-of-bound entities to keep the entity list tidy.
-         *
-         * Removes entities that are no longer relevant or that have moved far outside the visible game area.
-         */
-        void cleanupEntities();
+        std::mutex packetMutex;                          ///< Guards pendingPackets, filled by the network thread.
+        std::vector<std::vector<uint8_t>> pendingPackets; ///< Messages received and not processed yet.
+        std::vector<std::vector<uint8_t>> receivedPackets; ///< Messages being processed by the main thread.
 
         /**
          * @brief Processes leaderboard data received from the server.
@@ -205,13 +209,32 @@ namespace rtype {
         void createBackgroundEntities();
 
         /**
-         * @brief Processes an incoming message from the server.
+         * @brief Queues an incoming message from the server, called on the network thread.
          *
          * @param data   The received packet data.
          * @param sender The endpoint from which the packet was sent.
          */
         void handleNetworkMessage(const std::vector<uint8_t> &data, const asio::ip::udp::endpoint &sender);
 
+        /**
+         * @brief Processes the messages queued by handleNetworkMessage, on the main thread.
+         */
+        void processNetworkMessages();
+
+        /**
+         * @brief Processes a message from the server with its packet handler.
+         *
+         * @param data The received packet data.
+         */
+        void dispatchPacket(const std::vector<uint8_t> &data);
+
+        /**
+         * @brief Sends a heartbeat to the server if the last one is HEARTBEAT_INTERVAL old.
+         *
+         * @param now The time of the current frame.
+         */
+        void sendHeartbeat(std::chrono::steady_clock::time_point now);
+
         /**
          * @brief Sets up the parallax background for the menu screen.
          */
@@ -282,6 +305,22 @@ namespace rtype {
          */
         void handleEntityDeath(const std::vector<uint8_t>& data, size_t offset);
 
+        /**
+         * @brief Handles the entities removed by the server without dying.
+         *
+         * @param data   The received packet data.
+         * @param offset The offset at which the despawn packet begins.
+         */
+        void handleEntityDespawn(const std::vector<uint8_t>& data, size_t offset);
+
+        /**
+         * @brief Handles a chunk of the level geometry sent by the server.
+         *
+         * @param data   The received packet data.
+         * @param offset The offset at which the tile chunk packet begins.
+         */
+        void handleTileChunk(const std::vector<uint8_t>& data, size_t offset);
+
         /**
          * @brief Handles an entity update event from the server (position, velocity, etc.).
          *
@@ -290,6 +329,17 @@ namespace rtype {
          */
         void handleEntityUpdate(const std::vector<uint8_t>& data, size_t offset);
 
+        /**
+         * @brief Checks the generation of a server entity ID against the one mirrored locally.
+         *
+         * A newer generation means the server reused the ID, so the local entity is dropped.
+         *
+         * @param entity     The server entity ID.
+         * @param generation The generation carried by the packet.
+         * @return bool False if the packet is about an entity that was already destroyed, or an invalid ID.
+         */
+        bool syncGeneration(EntityID entity, EntityGeneration generation);
+
         /**
          * @brief Handles a BestScorePacket from the server, updating the player's best scores/time.
          *
@@ -343,14 +393,6 @@ namespace rtype {
          */
         void setupEnemyAnimation(int type, RenderComponent &renderComp);
 
-        /**
-         * @brief Sets up rendering for a wall entity.
-         *
-         * @param entity     The wall entity ID.
-         * @param renderComp A reference to the RenderComponent to configure.
-         */
-        void setupWallRenderComponent(EntityID entity, RenderComponent &renderComp);
-
         // =========================
         // == Menu & State       ==
         // =========================
@@ -384,6 +426,7 @@ namespace rtype {
 
         std::chrono::steady_clock::time_point lastUpdate =
             std::chrono::steady_clock::now(); ///< Used to measure delta time between frames.
+        std::chrono::steady_clock::time_point lastHeartbeat; ///< When the last heartbeat was sent to the server.
     };
 
 } // namespace rtype
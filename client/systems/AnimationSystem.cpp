@@ -6,20 +6,19 @@
 
 namespace rtype {
     void AnimationSystem::update(EntityManager& manager, float dt) {
-        for (EntityID entity = 0; entity < MAX_ENTITIES; ++entity) {
-            if (manager.hasComponent<RenderComponent>(entity) && !manager.hasComponent<Projectile>(entity)) {
-                auto& render = manager.getComponent<RenderComponent>(entity);
+        manager.forEach<RenderComponent>([&manager, dt](EntityID entity, RenderComponent& render) {
+            if (manager.hasComponent<Projectile>(entity))
+                return;
 
-                render.animationTimer += dt;
-                if (render.animationTimer >= render.frameTime) {
-                    render.animationTimer = 0;
-                    render.currentFrame = (render.currentFrame + 1) % render.frameCount;
+            render.animationTimer += dt;
+            if (render.animationTimer >= render.frameTime) {
+                render.animationTimer = 0;
+                render.currentFrame = (render.currentFrame + 1) % render.frameCount;
 
-                    int xPos = render.currentFrame * render.frameWidth;
+                int xPos = render.currentFrame * render.frameWidth;
 
-                    render.sprite.setTextureRect(sf::IntRect(xPos, render.Y, render.frameWidth, render.frameHeight));
-                }
+                render.sprite.setTextureRect(sf::IntRect(xPos, render.Y, render.frameWidth, render.frameHeight));
             }
-        }
+        });
     }
 }
\ No newline at end of file
@@ -16,6 +16,9 @@ namespace rtype {
     class AnimationSystem : public ISystem {
     public:
         void update(EntityManager& manager, float dt) override;
+        SystemAccess access() const override {
+            return {0, signatureOf<RenderComponent>(), false, false};
+        }
     };
 }
 
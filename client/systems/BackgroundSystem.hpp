@@ -15,6 +15,9 @@ namespace rtype {
     public:
         explicit BackgroundSystem(sf::RenderWindow& window) : window(window) {}
         void update(EntityManager& manager, float dt) override;
+        SystemAccess access() const override {
+            return {0, signatureOf<BackgroundComponent>(), false, true};
+        }
     private:
         sf::RenderWindow& window;
     };
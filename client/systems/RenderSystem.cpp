@@ -8,16 +8,10 @@
 
 namespace rtype {
     void RenderSystem::update(EntityManager& manager, [[maybe_unused]] float dt) {
-        for (EntityID entity = 0; entity < MAX_ENTITIES; ++entity) {
-            if (manager.hasComponent<Position>(entity) &&
-                manager.hasComponent<RenderComponent>(entity)) {
-                const auto& pos = manager.getComponent<Position>(entity);
-                auto& render = manager.getComponent<RenderComponent>(entity);
-
-                // Update sprite position
-                render.sprite.setPosition(pos.x, pos.y);
-                window.draw(render.sprite);
-                }
-        }
+        manager.forEach<const Position, RenderComponent>([this](EntityID, const Position& pos, RenderComponent& render) {
+            // Update sprite position
+            render.sprite.setPosition(pos.x, pos.y);
+            window.draw(render.sprite);
+        });
     }
 }
\ No newline at end of file
@@ -11,6 +11,9 @@ namespace rtype {
        explicit RenderSystem(sf::RenderWindow& window) : window(window) {
        }
        void update(EntityManager& manager, float dt) override;
+       SystemAccess access() const override {
+           return {signatureOf<Position>(), signatureOf<RenderComponent>(), false, true};
+       }
    private:
         sf::RenderWindow& window;
     };
@@ -0,0 +1,18 @@
+#include "TileRenderSystem.hpp"
+
+namespace rtype {
+    void TileRenderSystem::update([[maybe_unused]] EntityManager& manager, [[maybe_unused]] float dt) {
+        if (!wall.getTexture())
+        {
+            wall.setTexture(*ResourceManager::getInstance().getTexture("wall"));
+            wall.setTextureRect(sf::IntRect(0, 0, 167, 587));
+        }
+        // The wall texture is stretched over each run of solid tiles on screen
+        tiles.anyRun({0.0f, 0.0f, physics::WORLD_WIDTH, physics::WORLD_HEIGHT}, [this](const Position& corner, float width, float height) {
+            wall.setPosition(corner.x, corner.y);
+            wall.setScale(width / 167.0f, height / 587.0f);
+            window.draw(wall);
+            return false;
+        });
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "shared/ecs/EntityManager.hpp"
+#include "shared/systems/System.hpp"
+#include "shared/physics/TileMap.hpp"
+#include "manager/ResourceManager.hpp"
+
+namespace rtype {
+    /**
+     * @class TileRenderSystem
+     * @brief Draws the level geometry streamed by the server, one wall sprite per run of solid tiles
+     *
+     * Registered before the RenderSystem, so entities are drawn over the walls.
+     */
+    class TileRenderSystem : public ISystem {
+    public:
+        TileRenderSystem(sf::RenderWindow& window, const physics::TileMap& tiles) : window(window), tiles(tiles) {
+        }
+        void update(EntityManager& manager, float dt) override;
+        SystemAccess access() const override {
+            return {0, 0, false, true};
+        }
+    private:
+        sf::RenderWindow& window;
+        const physics::TileMap& tiles;
+        sf::Sprite wall;
+    };
+}
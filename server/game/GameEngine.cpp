@@ -1,17 +1,29 @@
 // server/game/GameEngine.cpp
 #include "GameEngine.hpp"
+#include <cmath>
 
 namespace rtype::game {
 
-    GameEngine::GameEngine(network::NetworkManager& networkManager)
-        : network(networkManager),
-          lastUpdate(std::chrono::steady_clock::now())
+    GameEngine::GameEngine(network::NetworkManager& networkManager, int tickRate, const std::string& databasePath, std::uint32_t seed)
+        : projectiles(entities.reserveIds(DEFAULT_PROJECTILE_CAPACITY)),
+          tileLevel(physics::TileLevel::parse(DEFAULT_TILE_LEVEL)),
+          network(networkManager),
+          tickRate(tickRate),
+          randomSeed(seed),
+          gen(seed)
     {
+        collisionMatrix.enable(LAYER_PLAYER_SHOT, LAYER_ENEMY);
+        collisionMatrix.enable(LAYER_ENEMY_SHOT, LAYER_PLAYER);
+        collisionMatrix.enable(LAYER_PLAYER, LAYER_PICKUP);
+        // Periodic spawns start with the first update
+        timers.schedule(1, GameTimer{GameTimerType::HEALTH_PACK_SPAWN});
         try {
-            dbManager = std::make_unique<database::DatabaseManager>("rtype_scores.db");
+            dbManager = std::make_unique<database::DatabaseManager>(databasePath);
             scoreRepository = std::make_unique<database::ScoreRepository>(*dbManager);
             userRepository = std::make_unique<database::UserRepository>(*dbManager);
-            systems.push_back(std::make_unique<MovementSystem>());
+            systems.push_back(std::make_unique<MovementSystem>(&tileMap));
+            systems.push_back(std::make_unique<WeaponSystem>(projectiles));
+            systems.push_back(std::make_unique<DespawnSystem>(&despawned));
         } catch (const std::exception& e) {
             std::cerr << "Failed to initialize: " << e.what() << std::endl;
             throw;
@@ -19,40 +31,78 @@ namespace rtype::game {
     }
 
     void GameEngine::broadcastWorldState() {
-        for (EntityID entity = 0; entity < MAX_ENTITIES; ++entity) {
-            if (!entities.hasComponent<Position>(entity) || !entities.hasComponent<Velocity>(entity))
-                continue;
+        // Only entities changed since the last broadcast are sent, a keyframe resends everything
+        // from time to time for new clients and lost packets
+        bool keyframe = ++ticksSinceKeyframe >= KEYFRAME_INTERVAL || currentLevel != lastBroadcastLevel;
+        if (keyframe)
+            ticksSinceKeyframe = 0;
+        const Tick since = keyframe ? 0 : lastBroadcastTick;
+
+        entities.view<const Position, const Velocity>().eachChanged(since, [this](EntityID entity, const Position& pos, const Velocity& vel) {
+            sendEntityState(entity, pos, vel);
+        });
+        // Players whose life or score changed without moving
+        entities.view<const Player, const Position, const Velocity>().eachChanged(since, [this, since](EntityID entity, const Player&, const Position& pos, const Velocity& vel) {
+            if (!entities.changedSince<Position>(entity, since) && !entities.changedSince<Velocity>(entity, since))
+                sendEntityState(entity, pos, vel);
+        });
+        broadcastProjectiles(keyframe);
+        if (keyframe)
+            tileMap.forEachChunk([this](const physics::TileChunk& chunk) { sendTileChunk(chunk); });
+
+        lastBroadcastTick = entities.currentTick();
+        lastBroadcastLevel = currentLevel;
+        entities.advanceTick();
+    }
 
-            const auto& pos = entities.getComponent<Position>(entity);
-            const auto& vel = entities.getComponent<Velocity>(entity);
+    void GameEngine::sendEntityState(EntityID entity, const Position& pos, const Velocity& vel) {
+        int type = 0;
+        int life = 0;
+        int score = 0;
+        const Signature signature = entities.getSignature(entity);
+
+        if (signature & componentBit<Player>()) {
+            const auto& player = entities.getComponent<const Player>(entity);
+            type = 0;
+            life = player.life;
+            score = player.score;
+        } else if (signature & componentBit<Enemy>()) {
+            if (!entities.getComponent<const Enemy>(entity).isBoss)
+                type = entities.hasTypeEnemy<Enemy>(entity);
+            else
+                type = 8;
+        } else if (signature & componentBit<HealthBonus>()) {
+            type = 6;
+        }
 
-            int type = 0;
-            int life = 0;
-            int score = 0;
+        network.broadcast(network.createEntityUpdatePacket(entities.getHandle(entity), type, pos, vel, life, score, currentLevel));
+    }
 
-            if (entities.hasComponent<Player>(entity)) {
-                const auto& player = entities.getComponent<Player>(entity);
-                type = 0;
-                life = player.life;
-                score = player.score;
-            } else if (entities.hasComponent<Projectile>(entity) && !entities.hasComponent<Enemy>(entity)) {
-                type = entities.getComponent<Projectile>(entity).isUltimate ? 5 : 1;
-            } else if (entities.hasComponent<Enemy>(entity)) {
-                if (!entities.getComponent<Enemy>(entity).isBoss)
-                    type = entities.hasTypeEnemy<Enemy>(entity);
-                else
-                    type = 8;
-            } else if (entities.hasComponent<HealthBonus>(entity)) {
-                type = 6;
-            } else if (entities.hasComponent<Wall>(entity)) {
-                type = 7;
+    void GameEngine::broadcastProjectiles(bool keyframe) {
+        // Projectiles fly straight, so clients only need them once: when spawned, or again on
+        // keyframes. The ones already retired are skipped.
+        const Position* positions = projectiles.positions();
+        const Velocity* velocities = projectiles.velocities();
+        auto send = [&](std::size_t row) {
+            const int type = projectiles.ultimates()[row] ? 5 : 1;
+            network.broadcast(network.createEntityUpdatePacket(projectiles.handleAt(row), type, positions[row], velocities[row], 0, 0, currentLevel));
+        };
+        if (keyframe) {
+            for (std::size_t row = 0; row < projectiles.size(); ++row)
+                send(row);
+        } else {
+            for (const EntityHandle& projectile : projectiles.spawned()) {
+                if (projectiles.isAlive(projectile))
+                    send(projectiles.rowOf(projectile.id));
             }
-
-            network.broadcast(network.createEntityUpdatePacket(entity, type, pos, vel, life, score, currentLevel));
         }
+        projectiles.clearSpawned();
     }
 
     EntityID GameEngine::createNewPlayer(const asio::ip::udp::endpoint& sender) {
+        std::lock_guard lock(stateMutex);
+        if (recorder)
+            recorder->record(lastTick, SessionEventType::CONNECT, sender);
         std::string clientId = sender.address().to_string() + ":" + std::to_string(sender.port());
         EntityID playerEntity = entities.createEntity();
         spawnEnemiesForLevel(1);
@@ -61,7 +111,13 @@ namespace rtype::game {
         entities.addComponent(playerEntity, Player{0, 10, 0});
         entities.addComponent(playerEntity, InputComponent{});
         entities.addComponent(playerEntity, NetworkComponent{static_cast<uint32_t>(playerEntity)});
-        playerEntities[clientId] = playerEntity;
+        entities.addComponent(playerEntity, Collider{LAYER_PLAYER, 20.0f});
+        Weapon weapon;
+        weapon.shot = ProjectilePrefab{300.0f, 1.0f};
+        weapon.ultimate = ProjectilePrefab{350.0f, 5.0f, 1, 0.0f, true};
+        entities.addComponent(playerEntity, weapon);
+        playerEntities[clientId] = entities.getHandle(playerEntity);
+        ticksSinceKeyframe = KEYFRAME_INTERVAL; // The new client needs the whole world
         gameStartTimes[clientId] = std::chrono::steady_clock::now();
         return playerEntity;
     }
@@ -77,8 +133,8 @@ namespace rtype::game {
             int enemiesKilled = 0;
             int score = 0;
             if (auto playerEntityIt = playerEntities.find(clientId);
-                playerEntityIt != playerEntities.end()) {
-                auto& player = entities.getComponent<Player>(playerEntityIt->second);
+                playerEntityIt != playerEntities.end() && entities.isValid(playerEntityIt->second)) {
+                auto& player = entities.getComponent<Player>(playerEntityIt->second.id);
                 score = player.score;
                 enemiesKilled = score;
             }
@@ -112,229 +168,374 @@ namespace rtype::game {
         }
     }
 
-    bool checkCollision(const Position& pos1, float radius1, const Position& pos2, float radius2) {
-        float dx = pos1.x - pos2.x;
-        float dy = pos1.y - pos2.y;
-        float distanceSquared = dx * dx + dy * dy;
-        float radiusSum = radius1 + radius2;
-        return distanceSquared <= (radiusSum * radiusSum);
+    void GameEngine::update(std::uint32_t tick, float dt) {
+        std::lock_guard lock(stateMutex);
+        network.setTick(tick);
+
+        timers.advanceTo(tick, [this](GameTimer& timer) {
+            handleTimer(timer);
+        });
+        if (pendingSpawns == 0 && entities.view<Enemy>().empty() && currentLevel != 4) {
+            auto packet = network.createLooseGamePacket();
+            network.broadcast(packet);
+        }
+        streamLevel(dt);
+        handleCollisions(dt);
+        projectiles.update(dt);
+
+        scheduler.run(systems, entities, dt);
+        broadcastDespawns();
+
+        broadcastWorldState();
+
+        lastTick = tick;
+        if (recorder)
+            recorder->recordHash(tick, stateHash());
+    }
+
+    void GameEngine::setRecorder(SessionRecorder* sessionRecorder) {
+        std::lock_guard lock(stateMutex);
+        recorder = sessionRecorder;
+    }
+
+    std::uint64_t GameEngine::stateHash() {
+        // FNV-1a over the values only, component padding is left out
+        std::uint64_t hash = 14695981039346656037ull;
+        auto mix = [&hash](const auto& value) {
+            const auto* bytes = reinterpret_cast<const unsigned char*>(&value);
+            for (std::size_t i = 0; i < sizeof(value); ++i) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+        };
+
+        mix(currentLevel);
+        mix(pendingSpawns);
+        mix(tileMap.scroll());
+        entities.view<const Position, const Velocity>().each([&](EntityID entity, const Position& pos, const Velocity& vel) {
+            mix(entity);
+            mix(entities.getSignature(entity));
+            mix(pos.x);
+            mix(pos.y);
+            mix(vel.dx);
+            mix(vel.dy);
+        });
+        mix(projectiles.size());
+        for (std::size_t row = 0; row < projectiles.size(); ++row) {
+            mix(projectiles.handleAt(row).id);
+            mix(projectiles.handleAt(row).generation);
+            mix(projectiles.positions()[row].x);
+            mix(projectiles.positions()[row].y);
+            mix(projectiles.velocities()[row].dx);
+            mix(projectiles.velocities()[row].dy);
+        }
+        entities.view<const Player>().each([&](EntityID entity, const Player& player) {
+            mix(entity);
+            mix(player.life);
+            mix(player.score);
+        });
+        entities.view<const Enemy>().each([&](EntityID entity, const Enemy& enemy) {
+            mix(entity);
+            mix(enemy.life);
+            mix(enemy.level);
+        });
+        return hash;
     }
 
-    void GameEngine::update() {
-        auto currentTime = std::chrono::steady_clock::now();
-        float dt = std::chrono::duration<float>(currentTime - lastUpdate).count();
-        lastUpdate = currentTime;
+    int GameEngine::randomInt(int bound) {
+        return std::uniform_int_distribution<int>(0, bound - 1)(gen);
+    }
 
-        handleHealthPackSpawns();
-        handleEnemySpawns(dt);
-        handleEnemyShoot();
-        handleCollisions();
-        handleWallSpawns();
+    std::uint32_t GameEngine::ticksFor(float seconds) const {
+        // The margin keeps exact multiples of the step from rounding up
+        const float ticks = std::ceil(seconds * static_cast<float>(tickRate) - 1e-3f);
+        return ticks < 1.0f ? 1 : static_cast<std::uint32_t>(ticks);
+    }
 
-        for (auto& system : systems) {
-            system->update(entities, dt);
+    void GameEngine::handleTimer(GameTimer& timer) {
+        switch (timer.type) {
+            case GameTimerType::ENEMY_SPAWN:
+                if (timer.wave == spawnWave) {
+                    pendingSpawns--;
+                    spawnEnemy(timer.spawn.x, timer.spawn.y, timer.spawn.level, timer.spawn.isBoss);
+                }
+                break;
+            case GameTimerType::HEALTH_PACK_SPAWN:
+                handleHealthPackSpawns();
+                timers.schedule(ticksFor(10.2f), timer);
+                break;
         }
+    }
 
-        broadcastWorldState();
+    void GameEngine::scheduleEnemySpawn(const PendingSpawn& spawn) {
+        GameTimer timer{GameTimerType::ENEMY_SPAWN};
+        timer.spawn = spawn;
+        timer.wave = spawnWave;
+        timers.schedule(ticksFor(spawn.delay), timer);
+        pendingSpawns++;
     }
 
-    void GameEngine::handleHealthPackSpawns() {
-        auto currentTime = std::chrono::steady_clock::now();
-        float dt = std::chrono::duration<float>(currentTime - lastUpdateHealthPack).count();
+    void GameEngine::clearEnemySpawns() {
+        // Spawns of the old wave are skipped when they fire
+        spawnWave++;
+        pendingSpawns = 0;
+    }
 
-        if (dt >= 10.2f)
-            lastUpdateHealthPack = currentTime;
-        else
-            return;
-        if (entities.getEntitiesWithComponents<HealthBonus>().size() > 3) {
-            lastUpdateHealthPack = currentTime;
+    void GameEngine::handleHealthPackSpawns() {
+        if (entities.view<HealthBonus>().size() > 3)
             return;
-        }
-        float x = static_cast<float>(rand() % 760);
-        float y = static_cast<float>(rand() % 560);
-        auto walls = entities.getEntitiesWithComponents<Wall>();
-        auto HealthPacks = entities.getEntitiesWithComponents<HealthBonus>();
-        bool stopLoop = false;
-        while (stopLoop != true) {
-            for (EntityID wall : walls) {
-                const auto& wallPos = entities.getComponent<Position>(wall);
-                if (!checkCollisionRect({x, y}, 25, wallPos, 20, 60)) {
-                    stopLoop = true;
-                    break;
-                }
-            }
+        auto HealthPacks = entities.view<HealthBonus>();
+        // A spot is free if it touches neither the level geometry nor another pack
+        auto isFree = [this, &HealthPacks](float x, float y) {
+            if (tileMap.circleHits({x, y}, 25))
+                return false;
             for (EntityID HealthPack : HealthPacks) {
-                const auto& HealthPackPos = entities.getComponent<Position>(HealthPack);
-                if (!checkCollisionRect({x, y}, 25, HealthPackPos, 20, 60)) {
-                    stopLoop = true;
-                    break;
-                }
+                const auto& HealthPackPos = entities.getComponent<const Position>(HealthPack);
+                if (physics::circleHitsRect({x, y}, 25, HealthPackPos, 20, 20))
+                    return false;
             }
-            if (stopLoop == false)
-                break;
-            x = static_cast<float>(rand() % 760);
-            y = static_cast<float>(rand() % 560);
+            return true;
+        };
+        float x = static_cast<float>(randomInt(760));
+        float y = static_cast<float>(randomInt(560));
+        int attempts = 1;
+        while (!isFree(x, y)) {
+            // The screen is crowded, the pack waits for the next spawn
+            if (attempts++ == HEALTH_PACK_PLACEMENT_ATTEMPTS)
+                return;
+            x = static_cast<float>(randomInt(760));
+            y = static_cast<float>(randomInt(560));
         }
         EntityID healthPackEntity = entities.createEntity();
         entities.addComponent(healthPackEntity, Position{x, y});
         entities.addComponent(healthPackEntity, HealthBonus{3});
         entities.addComponent(healthPackEntity, Velocity{0.0f, 0.0f});
+        entities.addComponent(healthPackEntity, Collider{LAYER_PICKUP, 0.0f, 20.0f, 20.0f});
     }
 
-    void GameEngine::handleWallSpawns() {
-        auto currentTime = std::chrono::steady_clock::now();
-        float dt = std::chrono::duration<float>(currentTime - lastUpdateWallShoot).count();
+    void GameEngine::streamLevel(float dt) {
+        tileMap.scrollBy(physics::LEVEL_SCROLL_SPEED * dt);
+        const std::uint32_t first = tileMap.firstVisibleChunk();
+        const std::uint32_t last = tileMap.lastVisibleChunk();
+        tileMap.unloadBefore(first);
+        for (std::uint32_t index = first; index <= last; ++index) {
+            if (tileMap.isLoaded(index))
+                continue;
+            const physics::TileChunk chunk = tileLevel.chunk(index);
+            tileMap.load(chunk);
+            sendTileChunk(chunk);
+        }
+    }
 
-        if (dt >= 1.2f)
-            lastUpdateWallShoot = currentTime;
-        else
-            return;
-        spawnWall(250, 100);
-        spawnWall(250, 450);
+    void GameEngine::sendTileChunk(const physics::TileChunk& chunk) {
+        network.broadcast(network.createTileChunkPacket(chunk, tileMap.scroll()));
     }
 
-    void GameEngine::handleEnemySpawns(float dt) {
-        for (auto it = enemySpawnQueue.begin(); it != enemySpawnQueue.end();) {
-            it->delay -= dt;
-            if (it->delay <= 0) {
-                spawnEnemy(it->x, it->y, it->level, it->isBoss);
-                it = enemySpawnQueue.erase(it);
-            } else {
-                ++it;
-            }
+    void GameEngine::handleCollisions(float dt) {
+        // Destructions are deferred until every pair is tested, destroyed entities are skipped meanwhile
+        auto& commands = collisionCommands;
+
+        // Only the pairs of nearby entities on colliding layers come out of the grid, sorted so each
+        // shot meets its targets before the walls. Boxes cover the motion of the tick.
+        collisionGrid.clear();
+        auto insertSwept = [this](EntityID entity, const Position& pos, const Collider& collider, const Velocity& motion) {
+            physics::Aabb box = physics::boundsOf(pos, collider);
+            const physics::Aabb end = physics::boundsOf({pos.x + motion.dx, pos.y + motion.dy}, collider);
+            box = {std::min(box.minX, end.minX), std::min(box.minY, end.minY), std::max(box.maxX, end.maxX), std::max(box.maxY, end.maxY)};
+            collisionGrid.insert(entity, collider.layer, box);
+        };
+        entities.view<const Position, const Collider>().each([this, dt, &insertSwept](EntityID entity, const Position& pos, const Collider& collider) {
+            insertSwept(entity, pos, collider, bodyOf(entity, dt).motion);
+        });
+        for (std::size_t row = 0; row < projectiles.size(); ++row) {
+            const Velocity& vel = projectiles.velocities()[row];
+            insertSwept(projectiles.handleAt(row).id, projectiles.positions()[row], Collider{projectiles.layers()[row], projectiles.radii()[row]}, {vel.dx * dt, vel.dy * dt});
         }
-        if (enemySpawnQueue.size() == 0 && entities.getEntitiesWithComponents<Enemy>().empty() && currentLevel != 4) {
-            auto packet = network.createLooseGamePacket();
-            network.broadcast(packet);
-        }
-    }
+        collisionGrid.build();
+        collisionGrid.collectPairs(collisionMatrix, collisionPairs);
+        testCollisionPairs(dt);
 
-    void GameEngine::handleEnemyShoot() {
-        auto currentTime = std::chrono::steady_clock::now();
-        if ( std::chrono::duration<float>(currentTime - lastUpdateBossShoot).count() >= 1.9f) { // shoot boss
-            auto enemies = entities.getEntitiesWithComponents<Enemy>();
-            lastUpdateBossShoot = currentTime;
+        for (std::size_t i = 0; i < collisionPairs.size(); ++i) {
+            const physics::CollisionPair& pair = collisionPairs[i];
+            if (!collisionHits[i])
+                continue;
+            // Projectiles are retired on the spot, entities at the end
+            if (projectiles.owns(pair.first) ? !projectiles.contains(pair.first) : commands.isPendingDestroy(pair.first))
+                continue;
+            if (commands.isPendingDestroy(pair.second))
+                continue;
 
-            for (EntityID enemy : enemies) {
-                if (entities.getComponent<Enemy>(enemy).isBoss == true) {
-                    shoot_system_.update(entities, enemy, true, 50);
-                    shoot_system_.update(entities, enemy, true, 0);
-                    shoot_system_.update(entities, enemy, true, -50);
-                }
+            if (pair.secondLayer == LAYER_PICKUP) {
+                const EntityID player = pair.first;
+                const EntityID healthPack = pair.second;
+                const int amount = entities.getComponent<const HealthBonus>(healthPack).healthAmount;
+                events.emit(PickupCollected{entities.getHandle(player), entities.getHandle(healthPack), amount});
+                events.emit(EntityDied{entities.getHandle(healthPack), entities.getHandle(player)});
+                commands.destroyEntity(entities.getHandle(healthPack));
+            } else if (pair.secondLayer == LAYER_ENEMY) {
+                handleCollision(pair.first, pair.second);
+            } else {
+                handleCollisionPlayer(pair.first, pair.second);
             }
         }
 
-        float dt = std::chrono::duration<float>(currentTime - lastUpdateEnemiesShoot).count();
-
-        if (dt >= 1.2f) { // shoot enemy
-            lastUpdateEnemiesShoot = currentTime;
-        } else {
-            return;
+        // The level geometry absorbs the projectiles still flying, after their targets. streamLevel
+        // already scrolled it to the end of the tick, so the sweep starts from where the projectile
+        // stood relative to the geometry at the start of the tick. Rows move when retired, hence
+        // the backward loop.
+        const float scrollStep = physics::LEVEL_SCROLL_SPEED * dt;
+        for (std::size_t row = projectiles.size(); row > 0; --row) {
+            const Position& pos = projectiles.positions()[row - 1];
+            const Velocity& vel = projectiles.velocities()[row - 1];
+            if (tileMap.sweptCircleHits({pos.x - scrollStep, pos.y}, {vel.dx * dt + scrollStep, vel.dy * dt}, projectiles.radii()[row - 1])) {
+                const EntityHandle missile = projectiles.handleAt(row - 1);
+                events.emit(EntityDied{missile, EntityHandle{}});
+                projectiles.retire(missile);
+            }
         }
 
-        auto enemies = entities.getEntitiesWithComponents<Enemy>();
+        // Outcomes are consumed once every pair is resolved: gameplay first, while the dead
+        // entities still exist, then the network in one batch
+        handleCollisionEvents();
+        commands.apply(entities);
+        broadcastDeaths();
+        events.clear();
+    }
 
-        for (EntityID enemy : enemies) {
-            shoot_system_.update(entities, enemy, false, 0);
+    GameEngine::CollisionBody GameEngine::bodyOf(EntityID entity, float dt) {
+        if (projectiles.owns(entity)) {
+            const std::size_t row = projectiles.rowOf(entity);
+            const Velocity& vel = projectiles.velocities()[row];
+            return {projectiles.positions()[row], Collider{projectiles.layers()[row], projectiles.radii()[row]}, {vel.dx * dt, vel.dy * dt}};
         }
+        CollisionBody body{entities.getComponent<const Position>(entity), entities.getComponent<const Collider>(entity), {0.0f, 0.0f}};
+        if (entities.hasComponent<Velocity>(entity)) {
+            const Velocity& vel = entities.getComponent<const Velocity>(entity);
+            body.motion = {vel.dx * dt, vel.dy * dt};
+        }
+        return body;
     }
 
-    void GameEngine::handleCollisions() {
-        auto missiles = entities.getEntitiesWithComponents<Projectile>();
-        auto enemies = entities.getEntitiesWithComponents<Enemy>();
-        auto walls = entities.getEntitiesWithComponents<Wall>();
-        auto players = entities.getEntitiesWithComponents<Player>();
-        auto healthPacks = entities.getEntitiesWithComponents<HealthBonus>();
-
-        for (EntityID missile : missiles) {
-            if (!entities.hasComponent<Position>(missile)) continue;
-
-            const auto& missilePos = entities.getComponent<Position>(missile);
-            const float missileRadius = 5.0f;
-
-            // Handle collision with enemies
-            for (EntityID enemy: enemies) {
-                if (!entities.hasComponent<Position>(enemy)) continue;
-
-                const auto& enemyPos = entities.getComponent<Position>(enemy);
-                const float enemyRadius = 20.0f;
-
-                if (checkCollision(missilePos, missileRadius, enemyPos, enemyRadius) && entities.getComponent<Projectile>(missile).lunchByType != 2) {
-                    handleCollision(missile, enemy);
+    void GameEngine::testCollisionPairs(float dt) {
+        collisionHits.assign(collisionPairs.size(), 0);
+
+        // Pairs are sorted by first entity: each run is one entity against all its candidates
+        for (std::size_t begin = 0, end = 0; begin < collisionPairs.size(); begin = end) {
+            const EntityID entity = collisionPairs[begin].first;
+            while (end < collisionPairs.size() && collisionPairs[end].first == entity)
+                ++end;
+            const CollisionBody body = bodyOf(entity, dt);
+            const Position& pos = body.pos;
+            const Collider& collider = body.collider;
+            const Velocity& motion = body.motion;
+
+            if (collider.width > 0.0f || collider.height > 0.0f) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    const CollisionBody other = bodyOf(collisionPairs[i].second, dt);
+                    collisionHits[i] = physics::intersects(pos, collider, other.pos, other.collider);
                 }
+                continue;
             }
-            for (EntityID player : players) {
-                const auto& playerPos = entities.getComponent<Position>(player);
-
-                if (checkCollision(missilePos, missileRadius, playerPos, 20.0f) && entities.getComponent<Projectile>(missile).lunchByType != 0) {
-                    handleCollisionPlayer(missile, player);
-                    break;
+            candidateCircles.clear();
+            candidateRects.clear();
+            circlePairs.clear();
+            rectPairs.clear();
+            for (std::size_t i = begin; i < end; ++i) {
+                const CollisionBody other = bodyOf(collisionPairs[i].second, dt);
+                const Position& otherPos = other.pos;
+                const Collider& otherCollider = other.collider;
+                // Relative to the candidate, a pair moving by more than the radius could tunnel
+                const Velocity& otherMotion = other.motion;
+                const Velocity relative{motion.dx - otherMotion.dx, motion.dy - otherMotion.dy};
+                if (relative.dx * relative.dx + relative.dy * relative.dy > collider.radius * collider.radius) {
+                    collisionHits[i] = physics::sweptIntersects(pos, relative, collider, otherPos, otherCollider);
+                } else if (otherCollider.width > 0.0f || otherCollider.height > 0.0f) {
+                    candidateRects.push(otherPos, otherCollider.width, otherCollider.height);
+                    rectPairs.push_back(i);
+                } else {
+                    candidateCircles.push(otherPos, otherCollider.radius);
+                    circlePairs.push_back(i);
                 }
             }
-            for (EntityID wall : walls) {
-                const auto& wallPos = entities.getComponent<Position>(wall);
+            hitMask.resize(std::max(physics::maskWords(candidateCircles.size()), physics::maskWords(candidateRects.size())));
+            physics::circleHitsCircles(pos, collider.radius, candidateCircles, hitMask.data());
+            for (std::size_t i = 0; i < circlePairs.size(); ++i)
+                collisionHits[circlePairs[i]] = (hitMask[i / 64] >> (i % 64)) & 1;
+            physics::circleHitsRects(pos, collider.radius, candidateRects, hitMask.data());
+            for (std::size_t i = 0; i < rectPairs.size(); ++i)
+                collisionHits[rectPairs[i]] = (hitMask[i / 64] >> (i % 64)) & 1;
+        }
+    }
 
-                if (checkCollisionRect(missilePos, missileRadius, wallPos, 20.0f, 60.0f) ) {
-                    handleCollisionPlayer(missile, wall);
-                    break;
-                }
+    void GameEngine::handleCollisionEvents() {
+        for (const ProjectileHit& hit : events.read<ProjectileHit>()) {
+            if (!entities.isValid(hit.target) || !entities.hasComponent<Player>(hit.target.id))
+                continue;
+            auto& player = entities.getComponent<Player>(hit.target.id);
+            player.life -= static_cast<int>(hit.damage);
+            if (player.life <= 0)
+                events.emit(EntityDied{hit.target, hit.projectile});
+        }
+        for (const PickupCollected& pickup : events.read<PickupCollected>()) {
+            if (entities.isValid(pickup.player))
+                entities.getComponent<Player>(pickup.player.id).life += pickup.amount;
+        }
+        // Scoring may switch level, which destroys the remaining enemies at once
+        for (const EntityDied& death : events.read<EntityDied>()) {
+            if (!entities.isValid(death.entity) || !entities.hasComponent<Enemy>(death.entity.id))
+                continue;
+            const bool isBoss = entities.getComponent<const Enemy>(death.entity.id).isBoss;
+            updatePlayerScore();
+            if (isBoss) {
+                bossOfLevelIsDead = true;
+                updatePlayerScore();
             }
         }
+    }
 
-        for (EntityID player : players) {
-            const auto& playerPos = entities.getComponent<Position>(player);
-
-            for (EntityID healthPack : healthPacks) {
-                const auto& healthPackPos = entities.getComponent<Position>(healthPack);
+    void GameEngine::broadcastDeaths() {
+        // A death packet carries two entities
+        const auto& deaths = events.read<EntityDied>();
+        for (std::size_t i = 0; i < deaths.size(); i += 2) {
+            EntityHandle second = i + 1 < deaths.size() ? deaths[i + 1].entity : EntityHandle{};
+            network.broadcast(network.createEntityDeathPacket(deaths[i].entity, second));
+        }
+    }
 
-                if (checkCollisionRect(playerPos, 20.0f, healthPackPos, 20.0f, 20.0f)) {
-                    auto& playerComp = entities.getComponent<Player>(player);
-                    playerComp.life += entities.getComponent<HealthBonus>(healthPack).healthAmount;
-                    auto packet = network.createEntityDeathPacket(-1, healthPack);
-                    network.broadcast(packet);
-                    entities.destroyEntity(healthPack);
-                }
-            }
+    void GameEngine::broadcastDespawns() {
+        despawned.insert(despawned.end(), projectiles.expired().begin(), projectiles.expired().end());
+        for (std::size_t i = 0; i < despawned.size(); i += network::MAX_DESPAWNS_PER_PACKET) {
+            const std::size_t count = std::min<std::size_t>(despawned.size() - i, network::MAX_DESPAWNS_PER_PACKET);
+            network.broadcast(network.createEntityDespawnPacket(despawned.data() + i, count));
         }
+        despawned.clear();
     }
 
     void GameEngine::handleCollision(EntityID missile, EntityID enemy) {
-        auto& projectile = entities.getComponent<Projectile>(missile);
-        entities.getComponent<Enemy>(enemy).life -= projectile.damage;
-
-        if (entities.getComponent<Enemy>(enemy).life <= 0) {
-            updatePlayerScore();
-            if (projectile.isUltimate) {
-                auto packet = network.createEntityDeathPacket(-1, enemy);
-                network.broadcast(packet);
-                entities.destroyEntity(enemy);
-            } else {
-                auto packet = network.createEntityDeathPacket(missile, enemy);
-                network.broadcast(packet);
-                entities.destroyEntity(enemy);
-                entities.destroyEntity(missile);
-            }
-            if (entities.getComponent<Enemy>(enemy).isBoss) {
-                bossOfLevelIsDead = true;
-                updatePlayerScore();
-            }
-        } else if (!projectile.isUltimate) {
-            auto packet = network.createEntityDeathPacket(missile, -1);
-            network.broadcast(packet);
-            entities.destroyEntity(missile);
+        const std::size_t row = projectiles.rowOf(missile);
+        const float damage = projectiles.damages()[row];
+        const EntityHandle missileHandle = projectiles.handleAt(row);
+        const EntityHandle enemyHandle = entities.getHandle(enemy);
+        // The enemy life is updated right away: it decides which later missiles still hit it
+        auto& enemyComp = entities.getComponent<Enemy>(enemy);
+        enemyComp.life -= damage;
+        events.emit(ProjectileHit{missileHandle, enemyHandle, damage});
+
+        if (enemyComp.life <= 0) {
+            events.emit(EntityDied{enemyHandle, missileHandle});
+            collisionCommands.destroyEntity(enemyHandle);
+        }
+        if (!projectiles.ultimates()[row]) {
+            events.emit(EntityDied{missileHandle, enemyHandle});
+            projectiles.retire(missileHandle);
         }
     }
 
     void GameEngine::handleCollisionPlayer(EntityID missile, EntityID player) {
-        entities.getComponent<Player>(player).life--;
-        auto packet = network.createEntityDeathPacket(missile, -1);
-        network.broadcast(packet);
-        entities.destroyEntity(missile);
-
-        if (entities.getComponent<Player>(player).life <= 0) {
-            packet = network.createEntityDeathPacket(-1, player);
-            network.broadcast(packet);
-        }
+        const EntityHandle missileHandle = projectiles.handleAt(projectiles.rowOf(missile));
+        events.emit(ProjectileHit{missileHandle, entities.getHandle(player), 1.0f});
+        events.emit(EntityDied{missileHandle, entities.getHandle(player)});
+        projectiles.retire(missileHandle);
     }
 
     std::tuple<float, int, float> GameEngine::getEnemyAttributes(int level) {
@@ -371,58 +572,50 @@ namespace rtype::game {
         }
         auto [life, damage, speedShoot] = getEnemyAttributes(enemyLevel);
 
+        const float shotSpeed = isBoss ? (speedShoot * 2) : speedShoot;
         entities.addComponent(enemyEntity, Enemy{
                 isBoss ? (damage * 3) : damage,
                 isBoss ? (life * 5) : life,
                 level,
-                isBoss ? (speedShoot * 2) : speedShoot,
+                shotSpeed,
                 isBoss
             }
         );
-    }
-
-    void GameEngine::spawnWall(float x, float y) {
-        EntityID wallEntity = entities.createEntity();
-        entities.addComponent(wallEntity, Position{x, y});
-        entities.addComponent(wallEntity, Velocity{0.0f, 0.0f});
-
-        entities.addComponent(wallEntity, Wall{1});
-    }
-
-    bool GameEngine::checkCollision(const Position& pos1, float radius1, const Position& pos2, float radius2) {
-        float dx = pos1.x - pos2.x;
-        float dy = pos1.y - pos2.y;
-        float distanceSquared = dx * dx + dy * dy;
-        float radiusSum = radius1 + radius2;
-        return distanceSquared <= (radiusSum * radiusSum);
-    }
-
-    bool GameEngine::checkCollisionRect(const Position& circlePos, float radius, const Position& rectPos, float rectWidth, float rectHeight) {
-        float closestX = std::max(rectPos.x, std::min(circlePos.x, rectPos.x + rectWidth));
-        float closestY = std::max(rectPos.y, std::min(circlePos.y, rectPos.y + rectHeight));
-
-        float dx = circlePos.x - closestX;
-        float dy = circlePos.y - closestY;
-
-        return (dx * dx + dy * dy) <= (radius * radius);
+        entities.addComponent(enemyEntity, Collider{LAYER_ENEMY, 20.0f});
+        entities.addComponent(enemyEntity, Bounds{-15.0f}); // Enemies that crossed the map are removed
+
+        // Enemies keep shooting on their own cooldown, bosses add a triple shot
+        Weapon weapon;
+        weapon.shot = ProjectilePrefab{-shotSpeed, 1.0f};
+        weapon.ultimate = ProjectilePrefab{-shotSpeed, 5.0f, 3, 50.0f, true};
+        weapon.cooldown = 1.2f;
+        weapon.ultimateCooldown = 1.9f;
+        weapon.layer = LAYER_ENEMY_SHOT;
+        weapon.owner = 2;
+        weapon.readyIn = weapon.cooldown;
+        weapon.ultimateReadyIn = weapon.ultimateCooldown;
+        weapon.trigger = true;
+        weapon.ultimateTrigger = isBoss;
+        weapon.automatic = true;
+        entities.addComponent(enemyEntity, weapon);
     }
 
     void GameEngine::updatePlayerScore() {
-        for (EntityID entity : entities.getEntitiesWithComponents<Player>()) {
+        for (EntityID entity : entities.view<Player>()) {
             auto& player = entities.getComponent<Player>(entity);
             player.score++;
             auto threshold = SCORE_THRESHOLDS.find(currentLevel);
             if (threshold != SCORE_THRESHOLDS.end() && player.score >= threshold->second) {
                 if (!hasBossIsDisplay && !bossOfLevelIsDead) {
-                    enemySpawnQueue.clear();
-                    enemySpawnQueue.push_back(PendingSpawn{static_cast<float>(1) * 2.0f, static_cast<float>(820), 300, currentLevel, true});
+                    clearEnemySpawns();
+                    scheduleEnemySpawn(PendingSpawn{static_cast<float>(1) * 2.0f, static_cast<float>(820), 300, currentLevel, true});
                     hasBossIsDisplay = true;
                     bossOfLevelIsDead = false;
                 } else if (hasBossIsDisplay && bossOfLevelIsDead) {
                     if (currentLevel == 3)
                         broadcastEndGameState();
                     currentLevel++;
-                    enemySpawnQueue.clear();
+                    clearEnemySpawns();
                     switchToNextLevel();
                     bossOfLevelIsDead = false;
                     hasBossIsDisplay = false;
@@ -432,24 +625,26 @@ namespace rtype::game {
     }
 
     void GameEngine::switchToNextLevel() {
-        auto enemies = entities.getEntitiesWithComponents<Enemy>();
-        for (EntityID enemy : enemies) {
-            entities.destroyEntity(enemy);
+        auto enemies = entities.view<Enemy>();
+        while (!enemies.empty()) {
+            entities.destroyEntity(*enemies.begin());
         }
 
-        enemySpawnQueue.clear();
+        clearEnemySpawns();
         spawnEnemiesForLevel(currentLevel);
     }
 
     void GameEngine::spawnEnemiesForLevel(int level) {
         const int ENEMIES_PER_LEVEL[] = {15, 15, 15};
+        if (level < 1 || level > 3) // The game is over after the third level
+            return;
         int nbEnemies = ENEMIES_PER_LEVEL[level - 1];
 
         for (int i = 0; i < nbEnemies; i++) {
             float delay = static_cast<float>(i) * 2.0f;
             auto x = static_cast<float>(820);
-            auto y = static_cast<float>(rand() % 560);
-            enemySpawnQueue.push_back(PendingSpawn{delay, x, y, level, false});
+            auto y = static_cast<float>(randomInt(560));
+            scheduleEnemySpawn(PendingSpawn{delay, x, y, level, false});
         }
     }
 
@@ -468,29 +663,18 @@ namespace rtype::game {
 
         if (header->type == static_cast<uint8_t>(network::PacketType::PLAYER_INPUT)) {
             auto it = playerEntities.find(clientId);
-            if (it == playerEntities.end()) return;
+            if (it == playerEntities.end() || !entities.isValid(it->second)) return;
 
-            EntityID playerEntity = it->second;
+            EntityID playerEntity = it->second.id;
             if (entities.hasComponent<Position>(playerEntity) &&
                 entities.hasComponent<Velocity>(playerEntity)) {
                 auto& vel = entities.getComponent<Velocity>(playerEntity);
-                auto& input = entities.getComponent<InputComponent>(playerEntity);
+                auto& weapon = entities.getComponent<Weapon>(playerEntity);
                 const auto* inputPacket = reinterpret_cast<const network::PlayerInputPacket*>(
                     data.data() + sizeof(network::PacketHeader));
-                if (inputPacket->space) {
-                    input.space = true;
-                }
-                if (inputPacket->ultimate) {
-                    input.Ultimate = true;
-                }
-                if (input.space) {
-                    shoot_system_.update(entities, playerEntity, false, 0);
-                    input.space = false;
-                }
-                if (input.Ultimate) {
-                    shoot_system_.update(entities, playerEntity, true, 0);
-                    input.Ultimate = false;
-                }
+                // The WeaponSystem fires on the next update, a shot between two updates is not lost
+                weapon.trigger |= inputPacket->space;
+                weapon.ultimateTrigger |= inputPacket->ultimate;
                 vel.dx = 0.0f;
                 vel.dy = 0.0f;
                 if (inputPacket->left) vel.dx = -speed;
@@ -542,19 +726,36 @@ namespace rtype::game {
     }
 
     void GameEngine::handleMessage(const std::vector<uint8_t>& data, const asio::ip::udp::endpoint& sender) {
+        std::lock_guard lock(stateMutex);
         sockaddr_in addr{};
         addr.sin_family = AF_INET;
         addr.sin_port = htons(sender.port());
         addr.sin_addr.s_addr = sender.address().to_v4().to_ulong();
         std::string clientId = sender.address().to_string() + ":" + std::to_string(sender.port());
+        if (recorder && data.size() >= sizeof(network::PacketHeader)) {
+            // Only the messages the game acts on are worth replaying
+            const auto type = reinterpret_cast<const network::PacketHeader*>(data.data())->type;
+            if (type == static_cast<uint8_t>(network::PacketType::CONNECT_REQUEST)
+                || (type == static_cast<uint8_t>(network::PacketType::PLAYER_INPUT) && playerEntities.count(clientId)))
+                recorder->record(lastTick, SessionEventType::MESSAGE, sender, data);
+        }
         handleNetworkMessage(data, addr, clientId);
     }
 
-    void GameEngine::handlePlayerDisconnection(const std::string& clientId) {
+    void GameEngine::handlePlayerDisconnection(const asio::ip::udp::endpoint& sender) {
+        std::lock_guard lock(stateMutex);
+        if (recorder)
+            recorder->record(lastTick, SessionEventType::DISCONNECT, sender);
+        const std::string clientId = sender.address().to_string() + ":" + std::to_string(sender.port());
         if (auto it = playerEntities.find(clientId); it != playerEntities.end()) {
-            EntityID entityId = it->second;
-            entities.destroyEntity(entityId);
+            if (entities.isValid(it->second)) {
+                // Announced with the despawns of the next tick, so the other clients drop the ship
+                despawned.push_back(it->second);
+                entities.destroyEntity(it->second.id);
+            }
             playerEntities.erase(it);
+            gameStartTimes.erase(clientId);
+            connectedUsers.erase(clientId);
             std::cout << "Player " << clientId << " disconnected" << std::endl;
         }
     }
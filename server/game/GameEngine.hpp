@@ -7,39 +7,93 @@
 #pragma once
 
 #include "../shared/ecs/EntityManager.hpp"
+#include "../shared/ecs/CommandBuffer.hpp"
+#include "../shared/ecs/Event.hpp"
+#include "../shared/ecs/EventBus.hpp"
 #include "../shared/systems/System.hpp"
 #include "../shared/abstracts/AEngine.hpp"
-#include "../shared/systems/ShootSystem.hpp"
 #include "../shared/network/packetType.hpp"
 #include "../network/NetworkManager.hpp"
 #include "../shared/systems/MouvementSystem.hpp"
+#include "../shared/systems/WeaponSystem.hpp"
+#include "../shared/systems/DespawnSystem.hpp"
+#include "../shared/systems/Scheduler.hpp"
+#include "../shared/systems/TickClock.hpp"
+#include "../shared/systems/TimerWheel.hpp"
+#include "../shared/systems/ProjectilePool.hpp"
+#include "../shared/physics/Broadphase.hpp"
+#include "../shared/physics/Narrowphase.hpp"
+#include "../shared/physics/TileMap.hpp"
 #include "../database/ScoreRepository.hpp"
 #include "../database/DatabaseManager.hpp"
+#include "SessionLog.hpp"
+#include "Levels.hpp"
 #include <unordered_map>
 #include <vector>
 #include <string>
 #include <chrono>
 #include <random>
 #include <map>
+#include <mutex>
 #include "../database/UserRepository.hpp"
 
 
 namespace rtype::game {
+    /**
+     * @brief Number of broadcasts between two keyframes sending every entity, about one second
+     */
+    constexpr int KEYFRAME_INTERVAL = 60;
+
+    /**
+     * @brief Random spots tried for a health pack before its spawn is skipped
+     */
+    constexpr int HEALTH_PACK_PLACEMENT_ATTEMPTS = 16;
+
+    /**
+     * @brief Kinds of timed game events
+     */
+    enum class GameTimerType : uint8_t {
+        ENEMY_SPAWN, ///< Spawns the enemy of spawn
+        HEALTH_PACK_SPAWN ///< Spawns a health pack, periodic
+    };
+
+    /**
+     * @brief Timed game event, scheduled on the timer wheel of the engine
+     */
+    struct GameTimer {
+        GameTimerType type = GameTimerType::ENEMY_SPAWN;
+        PendingSpawn spawn{}; ///< The enemy to spawn, ENEMY_SPAWN only
+        int wave = 0; ///< Spawn wave of the enemy, spawns of older waves were cancelled
+    };
 
     /**
      * @class GameEngine
      * @brief Manages the game logic and state.
+     *
+     * The simulation only depends on its seed, the tick steps and the calls to createNewPlayer,
+     * handleMessage and handlePlayerDisconnection between them: given the same ones, a replay
+     * reaches the same states. These calls and update are serialized by a lock, as the network
+     * thread makes the first ones.
      */
     class GameEngine : public engine::AEngine {
       public:
           /**
            * @brief Constructs a new GameEngine object.
            * @param networkManager Reference to the NetworkManager.
+           * @param tickRate Ticks per second of the updates, to convert the game delays into ticks.
+           * @param databasePath Path of the SQLite database, ":memory:" for a throwaway one.
+           * @param seed Seed of every random choice of the game, recorded to replay the session.
            */
-          GameEngine(network::NetworkManager& networkManager);
+          GameEngine(network::NetworkManager& networkManager, int tickRate = DEFAULT_TICK_RATE,
+              const std::string& databasePath = "rtype_scores.db", std::uint32_t seed = std::random_device{}());
 
           /**
            * @brief Broadcasts the current world state to all clients.
+           *
+           * Only the entities changed since the last broadcast are sent, except on keyframes.
+           * Projectiles are only sent when spawned, clients move them on their own. Keyframes also
+           * send the loaded chunks of the level geometry again.
+           * Starts a new tick of the entity manager.
            */
           void broadcastWorldState();
 
@@ -51,9 +105,11 @@ namespace rtype::game {
           EntityID createNewPlayer(const asio::ip::udp::endpoint& sender);
 
           /**
-           * @brief Updates the game state.
+           * @brief Updates the game state by one fixed step.
+           * @param tick The number of the tick, stamped into the packets sent during the step.
+           * @param dt The simulated time of the step, in seconds.
            */
-          void update() override;
+          void update(std::uint32_t tick, float dt) override;
 
           /**
            * @brief Handles incoming messages.
@@ -62,21 +118,64 @@ namespace rtype::game {
            */
           void handleMessage(const std::vector<uint8_t>& data, const asio::ip::udp::endpoint& sender) override;
 
+          /**
+           * @brief Gets the current level, 4 once the third one is finished.
+           */
+          int level() const { return currentLevel; }
+
+          /**
+           * @brief Handles the disconnection of a player, destroying its entity.
+           * @param sender The endpoint of the player.
+           */
+          void handlePlayerDisconnection(const asio::ip::udp::endpoint& sender);
+
+          /**
+           * @brief Gets the seed of the random choices of the game.
+           */
+          std::uint32_t seed() const { return randomSeed; }
+
+          /**
+           * @brief Records the session from now on: connections, messages, disconnections and the state hash of every tick.
+           * @param sessionRecorder The recorder, nullptr to stop recording. It must outlive the recording.
+           */
+          void setRecorder(SessionRecorder* sessionRecorder);
+
+          /**
+           * @brief Hashes the gameplay state: entities with their components, level and pending spawns.
+           *
+           * Two runs fed the same session have the same hash after every tick.
+           * @return The 64-bit FNV-1a hash of the state.
+           */
+          std::uint64_t stateHash();
+
       private:
-          ShootSystem shoot_system_; ///< System for handling shooting mechanics.
           std::vector<std::unique_ptr<ISystem>> systems; ///< List of systems in the game.
+          Scheduler scheduler; ///< Runs the systems of a tick in parallel when their accesses allow it.
           EntityManager entities; ///< Manages all entities in the game.
+          ProjectilePool projectiles; ///< Every projectile in the game, named by IDs reserved in entities.
+          std::vector<EntityHandle> despawned; ///< Entities and projectiles removed this tick without dying, announced together.
+          physics::TileLevel tileLevel; ///< Geometry of the level, looping.
+          physics::TileMap tileMap; ///< Chunks of the level geometry around the screen, scrolled every update.
           network::NetworkManager& network; ///< Reference to the network manager.
-          std::unordered_map<std::string, EntityID> playerEntities; ///< Maps player IDs to entity IDs.
-          std::chrono::steady_clock::time_point lastUpdate; ///< Time point of the last update.
-          std::chrono::steady_clock::time_point lastUpdateEnemiesShoot; ///< Time point of the last enemy shoot update.
-          std::chrono::steady_clock::time_point lastUpdateBossShoot; ///< Time point of the last boss shoot update.
-          std::chrono::steady_clock::time_point lastUpdateWallShoot; ///< Time point of the last wall shoot update.
-          std::chrono::steady_clock::time_point lastUpdateHealthPack; ///< Time point of the last health pack update.
+          std::unordered_map<std::string, EntityHandle> playerEntities; ///< Maps player IDs to handles on their entities.
+          TimerWheel<GameTimer> timers; ///< Spawns and cooldowns, advanced once per update.
+          int tickRate; ///< Ticks per second of the updates.
           float speed = 200.0f; ///< Speed of the entities.
-          std::vector<PendingSpawn> enemySpawnQueue; ///< Queue of enemies to be spawned.
-          std::random_device rd; ///< Random device for generating random numbers.
-          std::mt19937 gen; ///< Mersenne Twister random number generator.
+          int spawnWave = 0; ///< Current enemy spawn wave, clearing the spawns starts a new one.
+          int pendingSpawns = 0; ///< Enemies of the current wave still to spawn.
+          CommandBuffer collisionCommands; ///< Destructions recorded by handleCollisions, applied once every pair is tested.
+          EventBus events; ///< Outcomes of the collisions of the tick, consumed once every pair is tested.
+          physics::UniformGrid collisionGrid; ///< Colliders of the tick, rebuilt by handleCollisions.
+          physics::CollisionMatrix collisionMatrix; ///< Layers handled by handleCollisions, movers against walls are left to MovementSystem.
+          std::vector<physics::CollisionPair> collisionPairs; ///< Reused list of the candidate pairs of the tick.
+          std::vector<uint8_t> collisionHits; ///< Whether each candidate pair really collides.
+          physics::CircleSet candidateCircles; ///< Circular candidates of the entity being tested.
+          physics::RectSet candidateRects; ///< Rectangular candidates of the entity being tested.
+          std::vector<std::size_t> circlePairs; ///< Pair index of each candidate circle.
+          std::vector<std::size_t> rectPairs; ///< Pair index of each candidate rectangle.
+          std::vector<uint64_t> hitMask; ///< Hit mask returned by the narrow-phase kernels.
+          std::uint32_t randomSeed; ///< Seed of gen.
+          std::mt19937 gen; ///< Mersenne Twister random number generator, the only source of randomness of the game.
           std::uniform_real_distribution<float> dis; ///< Uniform real distribution for random numbers.
           std::unique_ptr<database::DatabaseManager> dbManager;
           std::unique_ptr<database::ScoreRepository> scoreRepository;
@@ -92,6 +191,20 @@ namespace rtype::game {
               {3, {5, 5, 600.0f}}
           }; ///< Attributes of enemies based on their level.
           int currentLevel = 1; ///< Current level of the game.
+          Tick lastBroadcastTick = 0; ///< Tick of the last broadcast, later changes are sent by the next one.
+          int lastBroadcastLevel = 0; ///< Level sent by the last broadcast, a level change triggers a keyframe.
+          int ticksSinceKeyframe = KEYFRAME_INTERVAL; ///< Broadcasts since the last keyframe.
+          std::mutex stateMutex; ///< Serializes the updates and the calls from the network thread.
+          SessionRecorder* recorder = nullptr; ///< Records the session when set.
+          std::uint32_t lastTick = 0; ///< Last tick run, stamped on the recorded events.
+
+          /**
+           * @brief Draws a random integer.
+           * @param bound The exclusive upper bound.
+           * @return An integer in [0, bound).
+           */
+          int randomInt(int bound);
+
           /**
            * @brief Switches to the next level.
            */
@@ -126,46 +239,121 @@ namespace rtype::game {
           void handleNetworkMessage(const std::vector<uint8_t>& data, const sockaddr_in& sender, const std::string& clientId);
 
           /**
-           * @brief Handles player disconnection.
-           * @param clientId The ID of the client.
+           * @brief Converts a game delay into ticks.
+           * @param seconds The delay in seconds.
+           * @return The number of ticks, at least one.
+           */
+          std::uint32_t ticksFor(float seconds) const;
+
+          /**
+           * @brief Runs a timed event fired by the timer wheel, scheduling the next one of periodic events.
+           * @param timer The event.
            */
-          void handlePlayerDisconnection(const std::string& clientId);
+          void handleTimer(GameTimer& timer);
 
           /**
-           * @brief Handles the spawning of enemies.
-           * @param dt The delta time since the last update.
+           * @brief Schedules the spawn of an enemy after its delay, in the current wave.
+           * @param spawn The enemy to spawn.
            */
-          void handleEnemySpawns(float dt);
+          void scheduleEnemySpawn(const PendingSpawn& spawn);
 
           /**
-           * @brief Handles the spawning of walls.
+           * @brief Cancels the pending enemy spawns by starting a new wave.
            */
-          void handleWallSpawns();
+          void clearEnemySpawns();
 
           /**
-           * @brief Handles enemy shooting.
+           * @brief Scrolls the level geometry, loading the chunks coming into view and broadcasting them once.
+           * @param dt The delta time of the tick.
            */
-          void handleEnemyShoot();
+          void streamLevel(float dt);
+
+          /**
+           * @brief Broadcasts a chunk of the level geometry with the current scroll.
+           * @param chunk The chunk.
+           */
+          void sendTileChunk(const physics::TileChunk& chunk);
 
           /**
            * @brief Handles collisions between entities.
+           * @param dt The delta time of the movement applied this tick, swept by fast entities.
+           */
+          void handleCollisions(float dt);
+
+          /**
+           * @brief Runs the exact shape tests of the candidate pairs into collisionHits.
+           *
+           * The candidates of each entity are packed and tested at once against its shape. Pairs
+           * moving by more than the radius of the entity in the tick are tested along their whole
+           * motion instead, so fast shots cannot tunnel through targets at low tick rates.
+           * @param dt The delta time of the movement applied this tick.
+           */
+          void testCollisionPairs(float dt);
+
+          /**
+           * @brief Collision shape of an entity or projectile and its displacement over a tick.
+           */
+          struct CollisionBody {
+              Position pos;
+              Collider collider;
+              Velocity motion; ///< The velocity times dt, none for entities without velocity.
+          };
+
+          /**
+           * @brief Gets the collision body of an entity of the manager or of a projectile of the pool.
+           * @param entity The ID of the entity or projectile.
+           * @param dt The delta time of the tick.
+           * @return The body, at its position before the movement of the tick.
+           */
+          CollisionBody bodyOf(EntityID entity, float dt);
+
+          /**
+           * @brief Applies the gameplay outcomes of the collision events: player damage, pickups and scoring.
+           *
+           * Called once every pair is tested, before the destructions are applied.
+           */
+          void handleCollisionEvents();
+
+          /**
+           * @brief Broadcasts the deaths of the tick, two per death packet.
            */
-          void handleCollisions();
+          void broadcastDeaths();
+
+          /**
+           * @brief Broadcasts the removals of the tick: projectiles expired in the pool and entities removed by the DespawnSystem.
+           *
+           * Sent as few despawn packets as possible, then the list is cleared.
+           */
+          void broadcastDespawns();
+
+          /**
+           * @brief Broadcasts the projectiles spawned since the last broadcast, or all of them on keyframes.
+           * @param keyframe Whether the broadcast is a keyframe.
+           */
+          void broadcastProjectiles(bool keyframe);
 
           /**
            * @brief Handles collision between a missile and an enemy.
-           * @param missile The ID of the missile entity.
+           * @param missile The ID of the missile in the projectile pool.
            * @param enemy The ID of the enemy entity.
            */
           void handleCollision(EntityID missile, EntityID enemy);
 
           /**
            * @brief Handles collision between a missile and a player.
-           * @param missile The ID of the missile entity.
+           * @param missile The ID of the missile in the projectile pool.
            * @param player The ID of the player entity.
            */
           void handleCollisionPlayer(EntityID missile, EntityID player);
 
+          /**
+           * @brief Broadcasts the state of one entity.
+           * @param entity The ID of the entity.
+           * @param pos The position of the entity.
+           * @param vel The velocity of the entity.
+           */
+          void sendEntityState(EntityID entity, const Position& pos, const Velocity& vel);
+
           /**
            * @brief Updates the player's score.
            */
@@ -176,27 +364,6 @@ namespace rtype::game {
            */
           void broadcastEndGameState();
 
-          /**
-           * @brief Checks for collision between two circular entities.
-           * @param pos1 The position of the first entity.
-           * @param radius1 The radius of the first entity.
-           * @param pos2 The position of the second entity.
-           * @param radius2 The radius of the second entity.
-           * @return True if the entities collide, false otherwise.
-           */
-          bool checkCollision(const Position& pos1, float radius1, const Position& pos2, float radius2);
-
-          /**
-           * @brief Checks for collision between a circular entity and a rectangular entity.
-           * @param circlePos The position of the circular entity.
-           * @param radius The radius of the circular entity.
-           * @param rectPos The position of the rectangular entity.
-           * @param rectWidth The width of the rectangular entity.
-           * @param rectHeight The height of the rectangular entity.
-           * @return True if the entities collide, false otherwise.
-           */
-          bool checkCollisionRect(const Position& circlePos, float radius, const Position& rectPos, float rectWidth, float rectHeight);
-
           /**
            * @brief Gets the attributes of an enemy based on its level.
            * @param level The level of the enemy.
@@ -211,13 +378,6 @@ namespace rtype::game {
            * @param level The level of the enemy.
            */
           void spawnEnemy(float x, float y, int level, bool isBoss);
-
-          /**
-           * @brief Spawns a wall at the given position.
-           * @param x The x-coordinate of the wall.
-           * @param y The y-coordinate of the wall.
-           */
-          void spawnWall(float x, float y);
     };
 
 } // namespace rtype::game
\ No newline at end of file
@@ -0,0 +1,47 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** Levels
+*/
+#pragma once
+
+namespace rtype::game {
+    /**
+     * @brief Geometry of the game, in the text format of physics::TileLevel
+     *
+     * An empty screen to start with, then pillars where the walls used to stand, bumps on the
+     * ceiling and the floor, and a block in the middle. The level loops.
+     */
+    inline constexpr const char* DEFAULT_TILE_LEVEL = R"(
+........................................................####....................................
+........................................................####....................................
+........................................................####....................................
+.........................................................##.....................................
+................................................................................................
+............................................#.................................#.................
+............................................#.................................#.................
+............................................#.................................#.................
+................................................................................................
+................................................................................................
+................................................................................................
+................................................................................................
+................................................................................................
+........................................................................................##......
+........................................................................................##......
+........................................................................................##......
+................................................................................................
+................................................................................................
+................................................................................................
+................................................................................................
+................................................................................................
+................................................................................................
+............................................#.................................#.................
+............................................#.................................#.................
+............................................#.................................#.................
+................................................................................................
+...................................................................##...........................
+..................................................................####..........................
+..................................................................####..........................
+..................................................................####..........................)";
+}
@@ -0,0 +1,46 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** Replay
+*/
+#include "Replay.hpp"
+#include "GameEngine.hpp"
+#include "network/HeadlessNetworkManager.hpp"
+#include <chrono>
+
+namespace rtype::game {
+    ReplayResult replaySession(const SessionLog& log) {
+        network::HeadlessNetworkManager network;
+        GameEngine engine(network, log.tickRate, ":memory:", log.seed);
+        const float dt = 1.0f / static_cast<float>(log.tickRate); // Same step as TickClock
+        const uint32_t lastTick = log.lastTick();
+        ReplayResult result;
+        std::size_t next = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32_t tick = 1; tick <= lastTick; ++tick) {
+            // Events recorded after tick - 1 happened before this one
+            for (; next < log.events.size() && log.events[next].tick < tick; ++next) {
+                const SessionEvent& event = log.events[next];
+                if (event.type == SessionEventType::CONNECT)
+                    engine.createNewPlayer(event.sender);
+                else if (event.type == SessionEventType::MESSAGE)
+                    engine.handleMessage(event.data, event.sender);
+                else
+                    engine.handlePlayerDisconnection(event.sender);
+            }
+            engine.update(tick, dt);
+            result.ticks = tick;
+
+            if (auto recorded = log.hashes.find(tick); recorded != log.hashes.end()) {
+                result.checkedHashes++;
+                if (result.firstMismatch == 0 && engine.stateHash() != recorded->second)
+                    result.firstMismatch = tick;
+            }
+        }
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result.packets = network.packets;
+        return result;
+    }
+}
@@ -0,0 +1,34 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** Replay
+*/
+#pragma once
+#include "SessionLog.hpp"
+#include <cstdint>
+
+namespace rtype::game {
+    /**
+     * @brief Outcome of a replay
+     */
+    struct ReplayResult {
+        uint32_t ticks = 0; ///< Ticks simulated
+        uint32_t checkedHashes = 0; ///< Ticks whose state was compared to the recorded one
+        uint32_t firstMismatch = 0; ///< First tick whose state differs from the recording, 0 if none
+        double seconds = 0.0; ///< Wall time spent simulating
+        uint64_t packets = 0; ///< Packets the game would have sent
+    };
+
+    /**
+     * @brief Re-simulates a recorded session headless, as fast as possible
+     *
+     * @details A new engine seeded like the recorded one, with a throwaway database and no
+     * sockets, is fed the events of the log between the same ticks. The state hash of every tick
+     * is compared to the recorded one: a mismatch means the simulation is not deterministic, or
+     * changed since the recording.
+     * @param log The session to replay
+     * @return ReplayResult What was replayed, how fast, and where it diverged
+     */
+    ReplayResult replaySession(const SessionLog& log);
+}
@@ -0,0 +1,97 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** SessionLog
+*/
+#include "SessionLog.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace rtype::game {
+    namespace {
+        constexpr char MAGIC[4] = {'R', 'T', 'S', 'L'};
+        constexpr uint16_t VERSION = 1;
+
+        template<typename T>
+        bool read(std::ifstream& file, T& value) {
+            return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+        }
+    }
+
+    SessionRecorder::SessionRecorder(const std::string& path, uint32_t seed, int tickRate) : _file(path, std::ios::binary | std::ios::trunc) {
+        if (!_file)
+            throw std::runtime_error("SessionRecorder: cannot create " + path);
+        _file.write(MAGIC, sizeof(MAGIC));
+        write(VERSION);
+        write(seed);
+        write(static_cast<int32_t>(tickRate));
+    }
+
+    void SessionRecorder::record(uint32_t tick, SessionEventType type, const asio::ip::udp::endpoint& sender, const std::vector<uint8_t>& data) {
+        const auto address = sender.address().to_v4().to_bytes();
+        write(type);
+        write(tick);
+        _file.write(reinterpret_cast<const char*>(address.data()), static_cast<std::streamsize>(address.size()));
+        write(sender.port());
+        write(static_cast<uint16_t>(data.size()));
+        _file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    }
+
+    void SessionRecorder::recordHash(uint32_t tick, uint64_t hash) {
+        write(SessionEventType::STATE_HASH);
+        write(tick);
+        write(hash);
+    }
+
+    SessionLog SessionLog::load(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            throw std::runtime_error("SessionLog: cannot open " + path);
+
+        char magic[sizeof(MAGIC)];
+        uint16_t version = 0;
+        int32_t tickRate = 0;
+        SessionLog log;
+        if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || !read(file, version) || version != VERSION)
+            throw std::runtime_error("SessionLog: " + path + " is not a session log");
+        if (!read(file, log.seed) || !read(file, tickRate) || tickRate <= 0)
+            throw std::runtime_error("SessionLog: truncated header in " + path);
+        log.tickRate = tickRate;
+
+        SessionEventType type;
+        uint32_t tick = 0;
+        while (read(file, type)) {
+            if (!read(file, tick))
+                throw std::runtime_error("SessionLog: truncated event in " + path);
+            if (type == SessionEventType::STATE_HASH) {
+                uint64_t hash = 0;
+                if (!read(file, hash))
+                    throw std::runtime_error("SessionLog: truncated event in " + path);
+                log.hashes[tick] = hash;
+                continue;
+            }
+            if (type > SessionEventType::STATE_HASH)
+                throw std::runtime_error("SessionLog: unknown event in " + path);
+
+            asio::ip::address_v4::bytes_type address;
+            uint16_t port = 0;
+            uint16_t size = 0;
+            if (!file.read(reinterpret_cast<char*>(address.data()), static_cast<std::streamsize>(address.size())) || !read(file, port) || !read(file, size))
+                throw std::runtime_error("SessionLog: truncated event in " + path);
+            SessionEvent event{tick, type, asio::ip::udp::endpoint(asio::ip::address_v4(address), port), std::vector<uint8_t>(size)};
+            if (size > 0 && !file.read(reinterpret_cast<char*>(event.data.data()), size))
+                throw std::runtime_error("SessionLog: truncated event in " + path);
+            log.events.push_back(std::move(event));
+        }
+        return log;
+    }
+
+    uint32_t SessionLog::lastTick() const {
+        uint32_t last = events.empty() ? 0 : events.back().tick;
+        for (const auto& [tick, hash] : hashes)
+            last = std::max(last, tick);
+        return last;
+    }
+}
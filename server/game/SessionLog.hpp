@@ -0,0 +1,96 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** SessionLog
+*/
+#pragma once
+#include <asio.hpp>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rtype::game {
+    /**
+     * @brief Kinds of recorded session events
+     */
+    enum class SessionEventType : uint8_t {
+        CONNECT, ///< A player joined, GameEngine::createNewPlayer
+        MESSAGE, ///< A packet handled by GameEngine::handleMessage
+        DISCONNECT, ///< A player timed out, GameEngine::handlePlayerDisconnection
+        STATE_HASH ///< Hash of the state at the end of a tick, GameEngine::stateHash
+    };
+
+    /**
+     * @brief One input of a session, with the number of ticks simulated before it
+     */
+    struct SessionEvent {
+        uint32_t tick; ///< Last tick run when the event happened, it applies before the next one
+        SessionEventType type;
+        asio::ip::udp::endpoint sender;
+        std::vector<uint8_t> data; ///< The packet, MESSAGE only
+    };
+
+    /**
+     * @class SessionRecorder
+     * @brief Writes everything a game session depends on, to replay it later
+     *
+     * @details The file starts with the seed of the engine and the tick rate, followed by the
+     * events in the order the engine handled them. The engine calls it under its state lock, so the
+     * order of the file is the order of the simulation. Values are written in host byte order: logs
+     * are replayed by a build of the same server.
+     */
+    class SessionRecorder {
+    public:
+        /**
+         * @brief Creates the log file and writes its header
+         * @throw std::runtime_error if the file cannot be created
+         */
+        SessionRecorder(const std::string& path, uint32_t seed, int tickRate);
+
+        /**
+         * @brief Records a connection, a message or a disconnection
+         */
+        void record(uint32_t tick, SessionEventType type, const asio::ip::udp::endpoint& sender, const std::vector<uint8_t>& data = {});
+
+        /**
+         * @brief Records the state hash at the end of a tick
+         */
+        void recordHash(uint32_t tick, uint64_t hash);
+
+        /**
+         * @brief Writes the buffered events to the file
+         */
+        void flush() { _file.flush(); }
+
+    private:
+        template<typename T>
+        void write(const T& value) { _file.write(reinterpret_cast<const char*>(&value), sizeof(T)); }
+
+        std::ofstream _file;
+    };
+
+    /**
+     * @struct SessionLog
+     * @brief A session read back from a file written by SessionRecorder
+     */
+    struct SessionLog {
+        uint32_t seed = 0;
+        int tickRate = 0;
+        std::vector<SessionEvent> events; ///< Connections, messages and disconnections, in order
+        std::unordered_map<uint32_t, uint64_t> hashes; ///< Recorded state hash of each tick
+
+        /**
+         * @brief Reads a log file
+         * @throw std::runtime_error if the file cannot be read or is not a session log
+         */
+        static SessionLog load(const std::string& path);
+
+        /**
+         * @brief Gets the number of the last tick the session ran
+         */
+        uint32_t lastTick() const;
+    };
+}
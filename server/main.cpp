@@ -1,9 +1,12 @@
 #include "manager/Manager.hpp"
+#include "game/Replay.hpp"
 #include <iostream>
 #include <csignal>
 #include <atomic>
 #include <thread>
 #include <chrono>
+#include <algorithm>
+#include <string>
 
 std::atomic<bool> running(true);
 
@@ -12,15 +15,37 @@ void signalHandler(int signum) {
     std::cout << "Interrupt signal (" << signum << ") received.\n";
 }
 
+int replay(const std::string& path) {
+    const auto log = rtype::game::SessionLog::load(path);
+    std::cout << "Replaying " << path << ": " << log.events.size() << " events, seed " << log.seed << ", "
+              << log.tickRate << " ticks per second" << std::endl;
+    const auto result = rtype::game::replaySession(log);
+    std::cout << result.ticks << " ticks in " << result.seconds << " s (" << result.ticks / std::max(result.seconds, 1e-9)
+              << " ticks per second), " << result.packets << " packets" << std::endl;
+    if (result.firstMismatch != 0) {
+        std::cout << "State diverged from the recording at tick " << result.firstMismatch << std::endl;
+        return 2;
+    }
+    std::cout << result.checkedHashes << " tick states identical to the recording" << std::endl;
+    return 0;
+}
+
 int main(int argc, char** argv) {
-    if (argc != 2) {
-        std::cerr << "Usage: " << argv[0] << " <port>" << std::endl;
+    if (argc < 2 || argc > 4 || (std::string(argv[1]) == "--replay" && argc != 3)) {
+        std::cerr << "Usage: " << argv[0] << " <port> [tick rate] [session log]" << std::endl;
+        std::cerr << "       " << argv[0] << " --replay <session log>" << std::endl;
         return 1;
     }
     try {
+        if (std::string(argv[1]) == "--replay")
+            return replay(argv[2]);
         uint16_t port = std::atoi(argv[1]);
-        std::cout << "Starting R-Type server on port " << port << std::endl;
-        rtype::Manager manager(port);
+        int tickRate = argc >= 3 ? std::atoi(argv[2]) : rtype::DEFAULT_TICK_RATE;
+        std::string sessionLog = argc == 4 ? argv[3] : "";
+        std::cout << "Starting R-Type server on port " << port << " at " << tickRate << " ticks per second" << std::endl;
+        if (!sessionLog.empty())
+            std::cout << "Recording the session to " << sessionLog << std::endl;
+        rtype::Manager manager(port, tickRate, sessionLog);
         manager.start();
         std::signal(SIGINT, signalHandler);
         while (running) {
@@ -1,7 +1,15 @@
 #include "Manager.hpp"
 
 namespace rtype {
-    Manager::Manager(uint16_t port) : network(port), game(std::make_unique<game::GameEngine>(network)), running(false) {
+    Manager::Manager(uint16_t port, int tickRate, const std::string& sessionLogPath) : network(port), game(std::make_unique<game::GameEngine>(network, tickRate)), running(false), clock(tickRate) {
+        if (!sessionLogPath.empty()) {
+            recorder = std::make_unique<game::SessionRecorder>(sessionLogPath, game->seed(), tickRate);
+            game->setRecorder(recorder.get());
+        }
+        network.setTickRate(tickRate);
+        network.setDisconnectCallback([this](const asio::ip::udp::endpoint& sender) {
+            game->handlePlayerDisconnection(sender);
+        });
         network.setMessageCallback([this](const std::vector<uint8_t>& data, const asio::ip::udp::endpoint& sender) {
             const auto* header = reinterpret_cast<const network::PacketHeader*>(data.data());
             if (header->type == static_cast<uint8_t>(network::PacketType::CONNECT_REQUEST)) {
@@ -18,7 +26,7 @@ namespace rtype {
                 respHeader->version = 1;
                 respHeader->type = static_cast<uint8_t>(network::PacketType::CONNECT_RESPONSE);
                 respHeader->length = response.size();
-                respHeader->sequence = 0;
+                respHeader->sequence = network.sequence();
 
                 connectResponse->success = true;
                 connectResponse->playerId = playerId;
@@ -32,10 +40,13 @@ namespace rtype {
     }
 
     void Manager::updateLoop() {
+        clock.start();
         while (running) {
             network.update();
-            game->update();
-            std::this_thread::sleep_for(std::chrono::milliseconds(16));
+            clock.update([this](std::uint32_t tick, float dt) {
+                game->update(tick, dt);
+            });
+            clock.sleepUntilNextTick();
         }
     }
 
@@ -50,7 +61,7 @@ namespace rtype {
         header->version = 1;
         header->type = static_cast<uint8_t>(network::PacketType::CONNECT_RESPONSE);
         header->length = response.size();
-        header->sequence = 0;
+        header->sequence = network.sequence();
 
         connectResponse->success = true;
         connectResponse->playerId = playerId;
@@ -70,5 +81,7 @@ namespace rtype {
             updateThread.join();
         }
         network.stop();
+        if (recorder)
+            recorder->flush();
     }
 }
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include <unordered_map>
 #include "../shared/game/PlayerInfo.hpp"
 #include "network/packetType.hpp"
+#include "../shared/systems/TickClock.hpp"
 
 namespace rtype {
 
@@ -24,8 +25,10 @@ namespace rtype {
         /**
          * @brief Constructs a new Manager object.
          * @param port The port number to bind the server.
+         * @param tickRate The number of simulation ticks per second.
+         * @param sessionLogPath File recording the session to replay it later, none if empty.
          */
-        Manager(uint16_t port);
+        Manager(uint16_t port, int tickRate = DEFAULT_TICK_RATE, const std::string& sessionLogPath = "");
 
         /**
          * @brief Starts the server and begins handling connections.
@@ -45,13 +48,18 @@ namespace rtype {
         void handleNewConnection(const asio::ip::udp::endpoint& sender);
 
         network::NetworkManager network; ///< Manages network communication.
+        std::unique_ptr<game::SessionRecorder> recorder; ///< Records the session when a log file is given.
         std::unique_ptr<game::GameEngine> game; ///< Manages the game logic and state.
         std::unordered_map<std::string, PlayerInfo> players; ///< Stores information about connected players.
         std::atomic<bool> running; ///< Indicates whether the server is running.
         std::thread updateThread; ///< Thread for running the update loop.
+        TickClock clock; ///< Paces the update loop at a fixed tick rate.
 
         /**
          * @brief The main loop for updating the game state.
+         *
+         * Runs the ticks due at the fixed tick rate, catching up after a slow tick, then sleeps
+         * until the next deadline.
          */
         void updateLoop();
     };
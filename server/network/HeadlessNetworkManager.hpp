@@ -0,0 +1,34 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** HeadlessNetworkManager
+*/
+#pragma once
+#include "NetworkManager.hpp"
+
+namespace rtype::network {
+    /**
+     * @class HeadlessNetworkManager
+     * @brief Network manager that never opens its socket and counts what the game sends
+     *
+     * Used to run a GameEngine without clients: replays and benchmarks.
+     */
+    class HeadlessNetworkManager : public NetworkManager {
+    public:
+        HeadlessNetworkManager() : NetworkManager(0) {}
+
+        void broadcast(const std::vector<uint8_t>& data) override {
+            packets++;
+            bytes += data.size();
+        }
+
+        void sendTo(const std::vector<uint8_t>& data, const asio::ip::udp::endpoint&) override {
+            packets++;
+            bytes += data.size();
+        }
+
+        std::uint64_t packets = 0; ///< Packets sent so far.
+        std::uint64_t bytes = 0; ///< Bytes sent so far.
+    };
+}
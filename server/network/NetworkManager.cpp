@@ -45,7 +45,7 @@ namespace rtype::network {
         header->version = 1;
         header->type = static_cast<uint8_t>(PacketType::SCORE_UPDATE);
         header->length = packet.size();
-        header->sequence = 0;
+        header->sequence = sequence();
 
         std::strncpy(scoreUpdate->username, username.c_str(), sizeof(scoreUpdate->username) - 1);
         scoreUpdate->username[sizeof(scoreUpdate->username) - 1] = '\0';
@@ -65,7 +65,7 @@ namespace rtype::network {
         header->version = 1;
         header->type = static_cast<uint8_t>(PacketType::BEST_SCORE);
         header->length = packet.size();
-        header->sequence = 0;
+        header->sequence = sequence();
 
         std::strncpy(bestScore->username, username.c_str(), sizeof(bestScore->username) - 1);
         bestScore->username[sizeof(bestScore->username) - 1] = '\0';
@@ -75,7 +75,8 @@ namespace rtype::network {
         return packet;
     }
 
-    const asio::ip::udp::endpoint& NetworkManager::getClientEndpoint(const std::string& clientId) const {
+    asio::ip::udp::endpoint NetworkManager::getClientEndpoint(const std::string& clientId) const {
+        std::lock_guard<std::mutex> lock(clientsMutex);
         auto it = clients.find(clientId);
         if (it == clients.end()) {
             throw std::runtime_error("Client not found: " + clientId);
@@ -83,7 +84,7 @@ namespace rtype::network {
         return it->second;
     }
 
-    std::vector<uint8_t> NetworkManager::createEntityUpdatePacket(EntityID entityId, int type, const Position& pos, const Velocity& vel,
+    std::vector<uint8_t> NetworkManager::createEntityUpdatePacket(EntityHandle entity, int type, const Position& pos, const Velocity& vel,
     int life, int score, int level) {
         std::vector<uint8_t> packet(sizeof(PacketHeader) + sizeof(EntityUpdatePacket));
         auto* header = reinterpret_cast<PacketHeader*>(packet.data());
@@ -94,9 +95,10 @@ namespace rtype::network {
         header->version = 1;
         header->type = static_cast<uint8_t>(PacketType::ENTITY_UPDATE);
         header->length = packet.size();
-        header->sequence = 0;
+        header->sequence = sequence();
 
-        update->entityId = entityId;
+        update->entityId = entity.id;
+        update->generation = entity.generation;
         update->type = type;
         update->x = pos.x;
         update->y = pos.y;
@@ -108,7 +110,7 @@ namespace rtype::network {
         return packet;
     }
 
-    std::vector<uint8_t> NetworkManager::createEntityDeathPacket(EntityID entity, EntityID missile) {
+    std::vector<uint8_t> NetworkManager::createEntityDeathPacket(EntityHandle entity, EntityHandle missile) {
         std::vector<uint8_t> packet(sizeof(PacketHeader) + sizeof(EntityUpdatePacket));
         auto* header = reinterpret_cast<PacketHeader*>(packet.data());
         auto* update = reinterpret_cast<EntityUpdatePacket*>(packet.data() + sizeof(PacketHeader));
@@ -118,15 +120,58 @@ namespace rtype::network {
         header->version = 1;
         header->type = static_cast<uint8_t>(PacketType::ENTITY_DEATH);
         header->length = packet.size();
-        header->sequence = 0;
+        header->sequence = sequence();
 
-        update->entityId = entity;
-        update->entityId2 = missile;
+        update->entityId = entity.id;
+        update->entityId2 = missile.id;
+        update->generation = entity.generation;
+        update->generation2 = missile.generation;
         update->type = 0;
 
         return packet;
     }
 
+    std::vector<uint8_t> NetworkManager::createEntityDespawnPacket(const EntityHandle* entities, std::size_t count) {
+        std::vector<uint8_t> packet(sizeof(PacketHeader) + sizeof(EntityDespawnPacket) + count * sizeof(DespawnEntry));
+        auto* header = reinterpret_cast<PacketHeader*>(packet.data());
+        auto* despawn = reinterpret_cast<EntityDespawnPacket*>(packet.data() + sizeof(PacketHeader));
+        auto* entries = reinterpret_cast<DespawnEntry*>(packet.data() + sizeof(PacketHeader) + sizeof(EntityDespawnPacket));
+
+        header->magic[0] = 'R';
+        header->magic[1] = 'T';
+        header->version = 1;
+        header->type = static_cast<uint8_t>(PacketType::ENTITY_DESPAWN);
+        header->length = packet.size();
+        header->sequence = sequence();
+
+        despawn->count = static_cast<uint32_t>(count);
+        for (std::size_t i = 0; i < count; ++i)
+            entries[i] = {static_cast<uint32_t>(entities[i].id), entities[i].generation};
+
+        return packet;
+    }
+
+    std::vector<uint8_t> NetworkManager::createTileChunkPacket(const physics::TileChunk& chunk, double scroll) {
+        static_assert(sizeof(TileChunkPacket::columns) == sizeof(physics::TileChunk::columns));
+        std::vector<uint8_t> packet(sizeof(PacketHeader) + sizeof(TileChunkPacket));
+        auto* header = reinterpret_cast<PacketHeader*>(packet.data());
+        auto* tiles = reinterpret_cast<TileChunkPacket*>(packet.data() + sizeof(PacketHeader));
+
+        header->magic[0] = 'R';
+        header->magic[1] = 'T';
+        header->version = 1;
+        header->type = static_cast<uint8_t>(PacketType::TILE_CHUNK);
+        header->length = packet.size();
+        header->sequence = sequence();
+
+        tiles->index = chunk.index;
+        tiles->scroll = scroll;
+        for (std::size_t i = 0; i < chunk.columns.size(); ++i)
+            tiles->columns[i] = chunk.columns[i];
+
+        return packet;
+    }
+
     std::vector<uint8_t> NetworkManager::createEndGamePacket() {
         std::vector<uint8_t> packet(sizeof(PacketHeader));
         auto* header = reinterpret_cast<PacketHeader*>(packet.data());
@@ -136,7 +181,7 @@ namespace rtype::network {
         header->version = 1;
         header->type = static_cast<uint8_t>(PacketType::END_GAME_STATE);
         header->length = packet.size();
-        header->sequence = 0;
+        header->sequence = sequence();
 
         return packet;
     }
@@ -150,7 +195,7 @@ namespace rtype::network {
         header->version = 1;
         header->type = static_cast<uint8_t>(PacketType::LOOSE_GAME_STATE);
         header->length = packet.size();
-        header->sequence = 0;
+        header->sequence = sequence();
 
         return packet;
     }
@@ -178,6 +223,7 @@ namespace rtype::network {
     }
 
     void NetworkManager::broadcast(const std::vector<uint8_t>& data) {
+        std::lock_guard<std::mutex> lock(clientsMutex);
         for (const auto& [id, client] : clients) {
             sendTo(data, client);
         }
@@ -194,7 +240,7 @@ namespace rtype::network {
         header->version = 1;
         header->type = static_cast<uint8_t>(PacketType::PLAYER_STATS);
         header->length = packet.size();
-        header->sequence = 0;
+        header->sequence = sequence();
 
         std::strncpy(stats->username, user.username.c_str(), sizeof(stats->username) - 1);
         stats->username[sizeof(stats->username) - 1] = '\0';
@@ -217,7 +263,7 @@ namespace rtype::network {
         header->version = 1;
         header->type = static_cast<uint8_t>(PacketType::BEST_SCORE);
         header->length = packet.size();
-        header->sequence = 0;
+        header->sequence = sequence();
 
         std::strncpy(bestScore->username, username.c_str(), sizeof(bestScore->username) - 1);
         bestScore->username[sizeof(bestScore->username) - 1] = '\0';
@@ -241,7 +287,7 @@ namespace rtype::network {
         header->version = 1;
         header->type = static_cast<uint8_t>(PacketType::GAME_STATS);
         header->length = packet.size();
-        header->sequence = 0;
+        header->sequence = sequence();
 
         stats->current_level = level;
         stats->enemies_killed = enemiesKilled;
@@ -264,7 +310,7 @@ namespace rtype::network {
         header->version = 1;
         header->type = static_cast<uint8_t>(PacketType::SCORE_UPDATE);
         header->length = packet.size();
-        header->sequence = 0;
+        header->sequence = sequence();
 
         std::strncpy(scoreUpdate->username, username.c_str(), sizeof(scoreUpdate->username) - 1);
         scoreUpdate->username[sizeof(scoreUpdate->username) - 1] = '\0';
@@ -286,7 +332,7 @@ namespace rtype::network {
         header->version = 1;
         header->type = static_cast<uint8_t>(PacketType::LEADERBOARD_RESPONSE);
         header->length = packet.size();
-        header->sequence = 0;
+        header->sequence = sequence();
 
         leaderboard->nb_entries = std::min(scores.size(), size_t(10));
         for (size_t i = 0; i < leaderboard->nb_entries; ++i) {
@@ -328,11 +374,17 @@ namespace rtype::network {
             std::string clientId = sender_endpoint.address().to_string() + ":" +
                                  std::to_string(sender_endpoint.port());
 
-            if (header->type == static_cast<uint8_t>(PacketType::CONNECT_REQUEST)) {
-                if (clients.find(clientId) == clients.end()) {
-                    clients[clientId] = sender_endpoint;
-                    std::cout << "New client connected: " << clientId << std::endl;
+            {
+                std::lock_guard<std::mutex> lock(clientsMutex);
+                if (header->type == static_cast<uint8_t>(PacketType::CONNECT_REQUEST)) {
+                    if (clients.find(clientId) == clients.end()) {
+                        clients[clientId] = sender_endpoint;
+                        std::cout << "New client connected: " << clientId << std::endl;
+                    }
                 }
+                // Any packet of a connected client keeps it alive, heartbeats included
+                if (clients.find(clientId) != clients.end())
+                    updateClientActivity(clientId);
             }
 
             if (messageCallback) {
@@ -356,38 +408,56 @@ namespace rtype::network {
         checkTimeouts();
     }
 
+    // Called with clientsMutex held
     void NetworkManager::updateClientActivity(const std::string& clientId) {
-        clientLastSeen[clientId] = std::chrono::steady_clock::now();
+        // A client has a single pending check, activity only moves the tick it compares to
+        if (clientLastSeen.insert_or_assign(clientId, currentTick.load()).second)
+            timeoutChecks.schedule(timeoutTicks + 1, clientId);
     }
 
     void NetworkManager::checkTimeouts() {
-        auto now = std::chrono::steady_clock::now();
-        std::vector<std::string> disconnectedClients;
-
-        for (const auto& [clientId, lastSeen] : clientLastSeen) {
-            if (std::chrono::duration_cast<std::chrono::seconds>(now - lastSeen).count() > 5) {
-                disconnectedClients.push_back(clientId);
+        // Only the checks falling due are visited, not every client
+        const uint32_t now = currentTick.load();
+        timedOutClients.clear();
+        disconnectedClients.clear();
+        {
+            std::lock_guard<std::mutex> lock(clientsMutex);
+            timeoutChecks.advanceTo(now, [this, now](std::string& clientId) {
+                auto it = clientLastSeen.find(clientId);
+                if (it == clientLastSeen.end())
+                    return;
+                const uint32_t silence = now - it->second;
+                if (silence > timeoutTicks)
+                    timedOutClients.push_back(std::move(clientId));
+                else
+                    timeoutChecks.schedule(timeoutTicks + 1 - silence, std::move(clientId));
+            });
+            for (const auto& clientId : timedOutClients) {
+                clientLastSeen.erase(clientId);
+                if (auto it = clients.find(clientId); it != clients.end()) {
+                    disconnectedClients.push_back(it->second);
+                    clients.erase(it);
+                }
             }
         }
 
-        for (const auto& clientId : disconnectedClients) {
-            handleClientDisconnection(clientId);
+        // Outside the lock: the callback locks the game, whose update broadcasts under its own lock
+        for (const auto& client : disconnectedClients) {
+            handleClientDisconnection(client);
         }
     }
 
-    void NetworkManager::handleClientDisconnection(const std::string& clientId) {
-        if (auto it = clients.find(clientId); it != clients.end()) {
-            clients.erase(it);
-            clientLastSeen.erase(clientId);
-            std::vector<uint8_t> packet(sizeof(PacketHeader));
-            auto* header = reinterpret_cast<PacketHeader*>(packet.data());
-            header->magic[0] = 'R';
-            header->magic[1] = 'T';
-            header->version = 1;
-            header->type = static_cast<uint8_t>(PacketType::DISCONNECT);
-            header->length = packet.size();
-
-            broadcast(packet);
-        }
+    void NetworkManager::handleClientDisconnection(const asio::ip::udp::endpoint& client) {
+        if (disconnectCallback)
+            disconnectCallback(client);
+        std::vector<uint8_t> packet(sizeof(PacketHeader));
+        auto* header = reinterpret_cast<PacketHeader*>(packet.data());
+        header->magic[0] = 'R';
+        header->magic[1] = 'T';
+        header->version = 1;
+        header->type = static_cast<uint8_t>(PacketType::DISCONNECT);
+        header->length = packet.size();
+
+        broadcast(packet);
     }
 }
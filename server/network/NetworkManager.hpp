@@ -2,6 +2,7 @@
 #include "../../shared/abstracts/ANetwork.hpp"
 #include <asio.hpp>
 #include <thread>
+#include <mutex>
 #include <vector>
 #include <functional>
 #include <unordered_map>
@@ -11,8 +12,12 @@
 #include "../database/DatabaseManager.hpp"
 #include "../database/UserRepository.hpp"
 #include "database/ScoreRepository.hpp"
+#include "../shared/systems/TickClock.hpp"
+#include "../shared/systems/TimerWheel.hpp"
+#include "../shared/physics/TileMap.hpp"
 
 namespace rtype::network {
+    constexpr int CLIENT_TIMEOUT_SECONDS = 5; ///< Silence after which a client is disconnected
     /**
      * @class NetworkManager
      * @brief Manages network communication for the server.
@@ -31,9 +36,14 @@ namespace rtype::network {
          */
         void start() override;
         /**
-         * @brief Updates the network manager.
+         * @brief Updates the network manager, disconnecting the clients that timed out by the current tick.
          */
         void update();
+        /**
+         * @brief Sets the number of ticks per second, to count the client timeouts in ticks.
+         * @param tickRate The tick rate of the simulation.
+         */
+        void setTickRate(int tickRate) { timeoutTicks = static_cast<uint32_t>(CLIENT_TIMEOUT_SECONDS * tickRate); }
         /**
          * @brief Stops the network manager and terminates all connections.
          */
@@ -43,21 +53,37 @@ namespace rtype::network {
          * @param callback The function to call when a message is received.
          */
         void setMessageCallback(std::function<void(const std::vector<uint8_t>&, const asio::ip::udp::endpoint&)> callback) override;
+        /**
+         * @brief Sets the function called when a client times out.
+         * @param callback The function to call with the endpoint of the client, from update().
+         */
+        void setDisconnectCallback(std::function<void(const asio::ip::udp::endpoint&)> callback) { disconnectCallback = std::move(callback); }
         /**
          * @brief Broadcasts a message to all connected clients.
          * @param data The message to send.
          */
-        void broadcast(const std::vector<uint8_t>& data);
+        virtual void broadcast(const std::vector<uint8_t>& data);
         /**
          * @brief Sends a message to a specific client.
          * @param data The message to send.
          * @param client The endpoint of the client to send to.
          */
-        void sendTo(const std::vector<uint8_t>& data, const asio::ip::udp::endpoint& client);
+        virtual void sendTo(const std::vector<uint8_t>& data, const asio::ip::udp::endpoint& client);
 
         std::vector<uint8_t> createScoreUpdatePacket(const std::string& username, int32_t time, int32_t score);
         std::vector<uint8_t> createBestScorePacket(const std::string& username, int32_t bestTime, int32_t gamesWon);
-        std::vector<uint8_t> createEntityDeathPacket(EntityID missile, EntityID enemy);
+        std::vector<uint8_t> createEntityDeathPacket(EntityHandle missile, EntityHandle enemy);
+        /**
+         * @brief Creates a packet announcing the removal of several entities.
+         * @param entities The removed entities, at most MAX_DESPAWNS_PER_PACKET.
+         */
+        std::vector<uint8_t> createEntityDespawnPacket(const EntityHandle* entities, std::size_t count);
+        /**
+         * @brief Creates a packet carrying a chunk of the level geometry.
+         * @param chunk The chunk.
+         * @param scroll The distance scrolled by the level.
+         */
+        std::vector<uint8_t> createTileChunkPacket(const physics::TileChunk& chunk, double scroll);
         std::vector<uint8_t> createEndGamePacket();
         std::vector<uint8_t> createLooseGamePacket();
         std::vector<uint8_t> createScoreUpdatePacket(const std::string& username, int time, int score, int levelReached, int enemiesKilled);
@@ -66,8 +92,17 @@ namespace rtype::network {
         std::vector<uint8_t> createGameStatsPacket(int level, int enemiesKilled, int score,
             int timeElapsed, int lifeRemaining);
         std::vector<uint8_t> createLeaderboardPacket(const std::vector<database::PlayerScore>& scores);
-        std::vector<uint8_t> createEntityUpdatePacket(EntityID entityId, int type, const Position& pos, const Velocity& vel,int life, int score, int level);
-        const asio::ip::udp::endpoint& getClientEndpoint(const std::string& clientId) const;
+        std::vector<uint8_t> createEntityUpdatePacket(EntityHandle entity, int type, const Position& pos, const Velocity& vel,int life, int score, int level);
+        asio::ip::udp::endpoint getClientEndpoint(const std::string& clientId) const;
+        /**
+         * @brief Sets the simulation tick stamped into the packets created from now on.
+         * @param tick The number of the tick being simulated.
+         */
+        void setTick(uint32_t tick) { currentTick = tick; }
+        /**
+         * @brief Gets the sequence number of the packets created now: the low 16 bits of the tick.
+         */
+        uint16_t sequence() const { return static_cast<uint16_t>(currentTick.load()); }
     private:
         /**
          * @brief Starts receiving messages from clients.
@@ -84,12 +119,19 @@ namespace rtype::network {
         asio::ip::udp::socket socket; ///< The socket for the network manager.
         std::thread io_thread; ///< The thread for running the IO context.
         std::atomic<bool> running; ///< Indicates whether the network manager is running.
+        std::atomic<uint32_t> currentTick{0}; ///< Simulation tick stamped into outgoing packets.
         std::vector<uint8_t> receive_buffer; ///< The buffer for receiving messages.
+        mutable std::mutex clientsMutex; ///< Guards clients and the timeouts, used by the IO and update threads. Never held while calling the callbacks.
         std::unordered_map<std::string, asio::ip::udp::endpoint> clients; ///< The connected clients.
         std::function<void(const std::vector<uint8_t>&, const asio::ip::udp::endpoint&)> messageCallback; ///< The message callback function.
-        void checkTimeouts(); ///< Checks for clients that have timed out.
-        void updateClientActivity(const std::string& client); ///< Updates the activity time for a client.
-        void handleClientDisconnection(const std::string& clientId); ///< Handles a client disconnection.
-        std::unordered_map<std::string, std::chrono::steady_clock::time_point> clientLastSeen; ///< The last time a client was active.
+        std::function<void(const asio::ip::udp::endpoint&)> disconnectCallback; ///< The disconnect callback function.
+        void checkTimeouts(); ///< Fires the timeout checks due by the current tick.
+        void updateClientActivity(const std::string& client); ///< Updates the activity tick for a client.
+        void handleClientDisconnection(const asio::ip::udp::endpoint& client); ///< Announces the disconnection of a client removed from clients.
+        std::unordered_map<std::string, uint32_t> clientLastSeen; ///< The last tick a client was active.
+        TimerWheel<std::string> timeoutChecks; ///< One pending check per active client, when it would time out.
+        std::vector<std::string> timedOutClients; ///< Reused list of the clients that timed out this update.
+        std::vector<asio::ip::udp::endpoint> disconnectedClients; ///< Endpoints of timedOutClients, announced once the lock is released.
+        uint32_t timeoutTicks = CLIENT_TIMEOUT_SECONDS * DEFAULT_TICK_RATE; ///< Silence after which a client is disconnected, in ticks.
     };
 }
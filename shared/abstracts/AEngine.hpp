@@ -13,7 +13,12 @@ namespace rtype::engine {
     class AEngine {
     public:
         virtual ~AEngine() = default;
-        virtual void update() = 0;
+        /**
+         * @brief Simulates one fixed step
+         * @param tick The number of the tick, increasing by one per call
+         * @param dt The simulated time of the step, in seconds
+         */
+        virtual void update(std::uint32_t tick, float dt) = 0;
         virtual void handleMessage(const std::vector<uint8_t>& data, const asio::ip::udp::endpoint& sender) = 0;
     protected:
         std::chrono::steady_clock::time_point lastUpdate = std::chrono::steady_clock::now();
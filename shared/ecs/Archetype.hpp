@@ -0,0 +1,289 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** Archetype
+*/
+#pragma once
+#include "Entity.hpp"
+#include "ComponentRegistry.hpp"
+#include <array>
+#include <vector>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace rtype {
+    /**
+     * @brief Size in bytes of one chunk of archetype storage
+     */
+    constexpr std::size_t CHUNK_SIZE = 16 * 1024;
+
+    /**
+     * @brief World tick, used as the version of a component (the tick of its last change)
+     */
+    using Tick = std::uint32_t;
+
+    /**
+     * @struct ComponentInfo
+     * @brief Type-erased description of a component type
+     *
+     * @details Holds what an archetype needs to lay out, move and destroy a component
+     * without knowing its static type.
+     */
+    struct ComponentInfo {
+        ComponentID id = 0;
+        std::size_t size = 0;
+        std::size_t align = 1;
+        void (*moveConstruct)(void* dst, void* src) = nullptr; ///< Move-constructs dst from src, then destroys src
+        void (*destroy)(void* ptr) = nullptr;
+
+        /**
+         * @brief Builds the description of a component type
+         * @tparam Component The component type to describe
+         * @return ComponentInfo The type-erased description
+         */
+        template<typename Component>
+        static ComponentInfo of() {
+            ComponentInfo info;
+            info.id = ComponentRegistry::id<Component>();
+            info.size = sizeof(Component);
+            info.align = alignof(Component);
+            info.moveConstruct = [](void* dst, void* src) {
+                auto* from = static_cast<Component*>(src);
+                new (dst) Component(std::move(*from));
+                from->~Component();
+            };
+            info.destroy = [](void* ptr) {
+                static_cast<Component*>(ptr)->~Component();
+            };
+            return info;
+        }
+    };
+
+    /**
+     * @class Archetype
+     * @brief Stores every entity that owns exactly the same set of components
+     *
+     * @details Rows are packed into fixed-size chunks: each chunk holds the entity IDs
+     * followed by one contiguous column per component type. Rows stay dense, a removed row
+     * is filled with the last one, so iterating an archetype only touches live data.
+     * Every component column has a matching column of Tick holding the version of each value.
+     * Chunks come from the memory resource of the world and are kept until the archetype is
+     * destroyed, so emptying and refilling an archetype does not allocate.
+     */
+    class Archetype {
+    public:
+        /**
+         * @brief Creates an archetype for a set of component types
+         * @param components The component types stored by this archetype, in any order
+         * @param memory The resource allocating the chunks, must outlive the archetype
+         */
+        explicit Archetype(std::vector<ComponentInfo> components, std::pmr::memory_resource* memory = std::pmr::new_delete_resource())
+            : _components(std::move(components)), _memory(memory) {
+            std::sort(_components.begin(), _components.end(), [](const ComponentInfo& a, const ComponentInfo& b) {
+                return a.id < b.id;
+            });
+            _columns.fill(_components.size());
+            std::size_t rowSize = sizeof(EntityID);
+            for (const auto& component : _components)
+                rowSize += component.size + component.align + sizeof(Tick) + alignof(Tick);
+            _chunkCapacity = std::max<std::size_t>(1, CHUNK_SIZE / rowSize);
+
+            std::size_t offset = sizeof(EntityID) * _chunkCapacity;
+            for (std::size_t i = 0; i < _components.size(); ++i) {
+                const auto& component = _components[i];
+                offset = (offset + component.align - 1) / component.align * component.align;
+                _offsets.push_back(offset);
+                _columns[component.id] = i;
+                _signature |= Signature{1} << component.id;
+                offset += component.size * _chunkCapacity;
+            }
+            for (std::size_t i = 0; i < _components.size(); ++i) {
+                offset = (offset + alignof(Tick) - 1) / alignof(Tick) * alignof(Tick);
+                _versionOffsets.push_back(offset);
+                offset += sizeof(Tick) * _chunkCapacity;
+            }
+            _chunkBytes = offset;
+        }
+
+        ~Archetype() {
+            for (std::size_t row = 0; row < _size; ++row)
+                destroyRow(row);
+            for (std::byte* chunk : _chunks)
+                _memory->deallocate(chunk, _chunkBytes, alignof(std::max_align_t));
+        }
+
+        Archetype(const Archetype&) = delete;
+        Archetype& operator=(const Archetype&) = delete;
+
+        /**
+         * @brief Gets the component types stored by this archetype, sorted by ID
+         */
+        const std::vector<ComponentInfo>& components() const { return _components; }
+
+        /**
+         * @brief Gets the signature shared by every entity of this archetype
+         */
+        Signature signature() const { return _signature; }
+
+        /**
+         * @brief Checks if this archetype stores all the component types of a mask
+         * @param mask The signature to test
+         * @return bool True if every bit of mask is set in the archetype signature
+         */
+        bool matches(Signature mask) const { return (_signature & mask) == mask; }
+
+        /**
+         * @brief Gets the column index of a component type
+         * @param id The component type to look for
+         * @return std::size_t The column index, or components().size() if absent
+         */
+        std::size_t columnOf(ComponentID id) const { return _columns[id]; }
+
+        /**
+         * @brief Gets the number of entities stored
+         */
+        std::size_t size() const { return _size; }
+
+        /**
+         * @brief Gets the number of rows a chunk can hold
+         */
+        std::size_t chunkCapacity() const { return _chunkCapacity; }
+
+        /**
+         * @brief Gets the number of chunks holding at least one row
+         */
+        std::size_t chunkCount() const { return (_size + _chunkCapacity - 1) / _chunkCapacity; }
+
+        /**
+         * @brief Gets the number of rows stored in a chunk
+         * @param chunk The chunk index
+         */
+        std::size_t chunkSize(std::size_t chunk) const {
+            return std::min(_chunkCapacity, _size - chunk * _chunkCapacity);
+        }
+
+        /**
+         * @brief Gets the entity IDs stored in a chunk
+         * @param chunk The chunk index
+         */
+        EntityID* entities(std::size_t chunk) const {
+            return reinterpret_cast<EntityID*>(_chunks[chunk]);
+        }
+
+        /**
+         * @brief Gets a typed column of a chunk
+         * @tparam Component The component type of the column
+         * @param chunk The chunk index
+         * @param column The column index of Component
+         */
+        template<typename Component>
+        Component* column(std::size_t chunk, std::size_t column) const {
+            return reinterpret_cast<Component*>(_chunks[chunk] + _offsets[column]);
+        }
+
+        /**
+         * @brief Gets the versions of a column of a chunk
+         * @param chunk The chunk index
+         * @param column The column index
+         */
+        Tick* versions(std::size_t chunk, std::size_t column) const {
+            return reinterpret_cast<Tick*>(_chunks[chunk] + _versionOffsets[column]);
+        }
+
+        /**
+         * @brief Gets the version of a component of a row
+         * @param column The column index
+         * @param row The row index
+         */
+        Tick& versionAt(std::size_t column, std::size_t row) const {
+            return versions(row / _chunkCapacity, column)[row % _chunkCapacity];
+        }
+
+        /**
+         * @brief Gets the address of a component of a row
+         * @param column The column index
+         * @param row The row index
+         */
+        void* at(std::size_t column, std::size_t row) const {
+            return _chunks[row / _chunkCapacity] + _offsets[column] + (row % _chunkCapacity) * _components[column].size;
+        }
+
+        /**
+         * @brief Gets the entity stored at a row
+         * @param row The row index
+         */
+        EntityID& entityAt(std::size_t row) const {
+            return entities(row / _chunkCapacity)[row % _chunkCapacity];
+        }
+
+        /**
+         * @brief Appends a row for an entity
+         * @details The component columns of the new row are left unconstructed, the caller
+         * must construct every one of them and set their versions.
+         * @param entity The entity owning the row
+         * @return std::size_t The index of the new row
+         */
+        std::size_t push(EntityID entity) {
+            if (_size == _chunks.size() * _chunkCapacity)
+                _chunks.push_back(static_cast<std::byte*>(_memory->allocate(_chunkBytes, alignof(std::max_align_t))));
+            std::size_t row = _size++;
+            entityAt(row) = entity;
+            return row;
+        }
+
+        /**
+         * @brief Destroys every component of a row
+         * @param row The row index
+         */
+        void destroyRow(std::size_t row) {
+            for (std::size_t column = 0; column < _components.size(); ++column)
+                _components[column].destroy(at(column, row));
+        }
+
+        /**
+         * @brief Fills a row whose components were destroyed or moved out with the last row
+         * @param row The row index to fill
+         * @return EntityID The entity moved into the row, or INVALID_ENTITY if none was moved
+         */
+        EntityID fillHole(std::size_t row) {
+            std::size_t last = --_size;
+            if (row == last)
+                return INVALID_ENTITY;
+            for (std::size_t column = 0; column < _components.size(); ++column) {
+                _components[column].moveConstruct(at(column, row), at(column, last));
+                versionAt(column, row) = versionAt(column, last);
+            }
+            entityAt(row) = entityAt(last);
+            return entityAt(row);
+        }
+
+        /**
+         * @brief Destroys every row, keeping the chunks allocated
+         */
+        void clear() {
+            for (std::size_t row = 0; row < _size; ++row)
+                destroyRow(row);
+            _size = 0;
+        }
+
+        std::array<Archetype*, MAX_COMPONENTS> addEdges{}; ///< Archetype reached by adding a component type
+        std::array<Archetype*, MAX_COMPONENTS> removeEdges{}; ///< Archetype reached by removing a component type
+
+    private:
+        std::vector<ComponentInfo> _components;
+        std::array<std::size_t, MAX_COMPONENTS> _columns{};
+        Signature _signature = 0;
+        std::vector<std::size_t> _offsets;
+        std::vector<std::size_t> _versionOffsets;
+        std::pmr::memory_resource* _memory;
+        std::vector<std::byte*> _chunks;
+        std::size_t _chunkCapacity = 1;
+        std::size_t _chunkBytes = 0;
+        std::size_t _size = 0;
+    };
+}
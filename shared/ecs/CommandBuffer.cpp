@@ -0,0 +1,45 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** CommandBuffer
+*/
+#include "CommandBuffer.hpp"
+
+namespace rtype {
+    void CommandBuffer::apply(EntityManager& manager) {
+        _created.clear();
+        try {
+            for (const Command& command : _commands) {
+                if (command.type == CommandType::Create) {
+                    _created.push_back(manager.createEntity());
+                    continue;
+                }
+                EntityID entity = command.target.id;
+                if (command.pending)
+                    entity = _created[entity];
+                else if (!manager.isValid(command.target))
+                    continue;
+
+                if (command.type == CommandType::Destroy)
+                    manager.destroyEntity(entity);
+                else
+                    command.function(*this, manager, entity, command.payload);
+            }
+        } catch (...) {
+            clear();
+            throw;
+        }
+        clear();
+    }
+
+    void CommandBuffer::clear() {
+        _commands.clear();
+        for (auto& pool : _payloads) {
+            if (pool)
+                pool->clear();
+        }
+        _destroyed.clear();
+        _pendingCount = 0;
+    }
+}
@@ -0,0 +1,187 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** CommandBuffer
+*/
+#pragma once
+#include "Entity.hpp"
+#include "EntityManager.hpp"
+#include <array>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace rtype {
+    /**
+     * @class CommandBuffer
+     * @brief Records structural changes during a system pass and applies them in one batch
+     *
+     * @details Creating or destroying entities and adding or removing components moves rows between
+     * archetypes, which is not allowed while a view is being iterated. A system records those
+     * changes in a CommandBuffer instead and calls apply() at a sync point, once it has finished
+     * iterating. Commands are applied in the order they were recorded.
+     *
+     * Existing entities are targeted through an EntityHandle: a command whose entity was destroyed
+     * before apply() (by an earlier command or by someone else) is skipped instead of resurrecting
+     * the ID. Component values are kept in one vector per component type, and every vector keeps its
+     * capacity after apply(), so a buffer reused every tick stops allocating.
+     *
+     * A CommandBuffer is not thread safe, give each system or thread its own buffer.
+     */
+    class CommandBuffer {
+    public:
+        /**
+         * @brief Entity created by the buffer, it only gets an EntityID when the buffer is applied
+         */
+        struct PendingEntity {
+            std::size_t index; ///< Index of the creation inside the buffer
+        };
+
+        /**
+         * @brief Records the creation of an entity
+         * @return PendingEntity Reference used to add components to the entity before it exists
+         */
+        PendingEntity createEntity() {
+            _commands.push_back({CommandType::Create, {_pendingCount, 0}, true, nullptr, 0});
+            return {_pendingCount++};
+        }
+
+        /**
+         * @brief Records the destruction of an entity
+         * @param entity Handle on the entity to destroy
+         */
+        void destroyEntity(EntityHandle entity) {
+            _commands.push_back({CommandType::Destroy, entity, false, nullptr, 0});
+            _destroyed.push_back(entity.id);
+        }
+
+        /**
+         * @brief Records the addition of a component to an existing entity
+         * @details If the entity already has the component when the buffer is applied, it is overwritten.
+         * @tparam Component The type of component to add
+         * @param entity Handle on the entity receiving the component
+         * @param component The component instance to add
+         */
+        template<typename Component>
+        void addComponent(EntityHandle entity, Component component) {
+            pushAdd(entity, false, std::move(component));
+        }
+
+        /**
+         * @brief Records the addition of a component to an entity created by this buffer
+         * @tparam Component The type of component to add
+         * @param entity The pending entity receiving the component
+         * @param component The component instance to add
+         */
+        template<typename Component>
+        void addComponent(PendingEntity entity, Component component) {
+            pushAdd({entity.index, 0}, true, std::move(component));
+        }
+
+        /**
+         * @brief Records the removal of a component from an existing entity
+         * @tparam Component The type of component to remove
+         * @param entity Handle on the entity losing the component
+         */
+        template<typename Component>
+        void removeComponent(EntityHandle entity) {
+            _commands.push_back({CommandType::Remove, entity, false, [](CommandBuffer&, EntityManager& manager, EntityID target, std::size_t) {
+                manager.removeComponent<Component>(target);
+            }, 0});
+        }
+
+        /**
+         * @brief Checks if the destruction of an entity has been recorded and not applied yet
+         * @details Lets a system skip entities it already destroyed during the same pass. The search
+         * is linear, which is cheaper than a set for the few destructions a tick records.
+         * @param entity The entity ID
+         * @return bool True if a destruction of the entity is pending
+         */
+        bool isPendingDestroy(EntityID entity) const {
+            for (EntityID destroyed : _destroyed) {
+                if (destroyed == entity)
+                    return true;
+            }
+            return false;
+        }
+
+        /**
+         * @brief Checks if no command is recorded
+         */
+        bool empty() const { return _commands.empty(); }
+
+        /**
+         * @brief Gets the number of recorded commands
+         */
+        std::size_t size() const { return _commands.size(); }
+
+        /**
+         * @brief Applies every recorded command to a manager, then clears the buffer
+         * @details Must not be called while the manager is being iterated.
+         * @param manager The EntityManager receiving the changes
+         * @throw std::runtime_error if an entity cannot be created
+         */
+        void apply(EntityManager& manager);
+
+        /**
+         * @brief Drops every recorded command without applying it
+         */
+        void clear();
+
+    private:
+        enum class CommandType {
+            Create,
+            Destroy,
+            Add,
+            Remove
+        };
+
+        using CommandFunction = void (*)(CommandBuffer& buffer, EntityManager& manager, EntityID target, std::size_t payload);
+
+        struct Command {
+            CommandType type;
+            EntityHandle target; ///< Entity of the command, or index of a pending entity
+            bool pending; ///< True if target.id is the index of an entity created by this buffer
+            CommandFunction function; ///< Applies Add and Remove commands
+            std::size_t payload; ///< Index of the component value in its payload vector
+        };
+
+        /**
+         * @brief Type-erased vector of recorded component values
+         */
+        struct IPayloadPool {
+            virtual ~IPayloadPool() = default;
+            virtual void clear() = 0;
+        };
+
+        template<typename Component>
+        struct PayloadPool : IPayloadPool {
+            std::vector<Component> values;
+            void clear() override { values.clear(); }
+        };
+
+        template<typename Component>
+        std::vector<Component>& payloads() {
+            auto& pool = _payloads[ComponentRegistry::id<Component>()];
+            if (!pool)
+                pool = std::make_unique<PayloadPool<Component>>();
+            return static_cast<PayloadPool<Component>&>(*pool).values;
+        }
+
+        template<typename Component>
+        void pushAdd(EntityHandle target, bool pending, Component component) {
+            auto& values = payloads<Component>();
+            values.push_back(std::move(component));
+            _commands.push_back({CommandType::Add, target, pending, [](CommandBuffer& buffer, EntityManager& manager, EntityID entity, std::size_t payload) {
+                manager.addComponent(entity, std::move(buffer.payloads<Component>()[payload]));
+            }, values.size() - 1});
+        }
+
+        std::vector<Command> _commands;
+        std::array<std::unique_ptr<IPayloadPool>, MAX_COMPONENTS> _payloads;
+        std::vector<EntityID> _created; ///< IDs given to the pending entities while applying
+        std::vector<EntityID> _destroyed; ///< Entities whose destruction is recorded
+        std::size_t _pendingCount = 0;
+    };
+}
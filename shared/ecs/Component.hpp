@@ -76,16 +76,88 @@ namespace rtype {
         bool isBoss;
     };
     /**
-     * @brief Health component for the ECS
+     * @brief Wall tag for the ECS, walls are stored as a bitset (see EntityManager::tagged)
      */
-    struct Wall {
-        int color;
-    };
+    struct Wall {};
     /**
      * @brief Health component for the ECS
      */
     struct HealthBonus {
         int healthAmount = 3;
     };
+    /**
+     * @brief Collision layers, one bit each
+     *
+     * Shots come first so the shot is always the first entity of a pair (see physics::CollisionPair).
+     */
+    enum CollisionLayer : uint32_t {
+        LAYER_PLAYER_SHOT = 1 << 0,
+        LAYER_ENEMY_SHOT = 1 << 1,
+        LAYER_PLAYER = 1 << 2,
+        LAYER_ENEMY = 1 << 3,
+        LAYER_WALL = 1 << 4,
+        LAYER_PICKUP = 1 << 5
+    };
+    /**
+     * @brief Collider component for the ECS
+     *
+     * A circle of the given radius centered on the Position, or a rectangle whose top-left
+     * corner is the Position when width and height are set.
+     */
+    struct Collider {
+        uint32_t layer; ///< One CollisionLayer bit
+        float radius = 0.0f;
+        float width = 0.0f;
+        float height = 0.0f;
+    };
+    /**
+     * @brief Projectiles of one shot of a Weapon
+     *
+     * The count projectiles of a shot fan out vertically, spread apart in vertical speed and
+     * centered on a horizontal shot.
+     */
+    struct ProjectilePrefab {
+        float speed = 0.0f; ///< Horizontal speed, negative to the left
+        float damage = 1.0f;
+        int count = 1; ///< Projectiles per shot
+        float spread = 0.0f; ///< Vertical speed between two projectiles of the shot
+        bool isUltimate = false;
+    };
+    /**
+     * @brief Weapon component for the ECS, fired by the WeaponSystem
+     *
+     * Each weapon has its own cooldowns. Triggers are released after every tick, unless the weapon
+     * is automatic: it then fires whenever a pulled trigger is ready.
+     */
+    struct Weapon {
+        ProjectilePrefab shot;
+        ProjectilePrefab ultimate;
+        float cooldown = 0.2f; ///< Seconds between two shots
+        float ultimateCooldown = 5.0f; ///< Seconds between two ultimates
+        uint32_t layer = LAYER_PLAYER_SHOT; ///< CollisionLayer of the projectiles
+        int owner = 0; ///< Projectile::lunchByType of the projectiles
+        float readyIn = 0.0f; ///< Seconds until the next shot
+        float ultimateReadyIn = 0.0f; ///< Seconds until the next ultimate
+        bool trigger = false;
+        bool ultimateTrigger = false;
+        bool automatic = false;
+    };
+    /**
+     * @brief Lifetime component for the ECS, the DespawnSystem removes the entity when it runs out
+     */
+    struct Lifetime {
+        float remaining = 0.0f; ///< Seconds left
+    };
+    /**
+     * @brief Bounds component for the ECS, the DespawnSystem removes the entity once its position leaves them
+     *
+     * The default is the screen with a margin: enemies spawn and shoot from just past the right edge.
+     */
+    struct Bounds {
+        float minX = -64.0f;
+        float minY = -64.0f;
+        float maxX = 864.0f;
+        float maxY = 664.0f;
+    };
 
 }
\ No newline at end of file
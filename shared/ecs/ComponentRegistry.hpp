@@ -0,0 +1,137 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** ComponentRegistry
+*/
+#pragma once
+#include "Component.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+namespace rtype {
+    /**
+     * @brief Maximum number of component types known by the ECS
+     */
+    constexpr std::size_t MAX_COMPONENTS = 64;
+    /**
+     * @brief Component type ID, used as a bit index in a Signature
+     */
+    using ComponentID = std::size_t;
+    /**
+     * @brief Bitset of the component types owned by an entity (bit N set = has component ID N)
+     */
+    using Signature = std::uint64_t;
+
+    static_assert(MAX_COMPONENTS <= sizeof(Signature) * 8, "Signature is too small for MAX_COMPONENTS");
+
+    /**
+     * @brief List of component types
+     */
+    template<typename... Components>
+    struct ComponentList {
+        static constexpr std::size_t size = sizeof...(Components);
+    };
+
+    /**
+     * @brief Components shared by the client and the server, their IDs are assigned at compile time
+     * @details Append new shared components at the end to keep existing IDs stable.
+     */
+    using SharedComponents = ComponentList<
+        Position,
+        Velocity,
+        Player,
+        InputComponent,
+        PendingSpawn,
+        NetworkComponent,
+        Projectile,
+        Enemy,
+        Wall,
+        HealthBonus,
+        Collider,
+        Weapon,
+        Lifetime,
+        Bounds
+    >;
+
+    /**
+     * @class ComponentRegistry
+     * @brief Assigns a unique ID to every component type
+     *
+     * @details Types listed in SharedComponents get their index in the list as a constexpr ID.
+     * Other types (client-only components such as RenderComponent) get the next free ID the first
+     * time they are used.
+     */
+    class ComponentRegistry {
+    public:
+        /**
+         * @brief Checks if a component type is part of SharedComponents
+         */
+        template<typename Component>
+        static constexpr bool isShared() {
+            return indexIn<Component>(SharedComponents{}) < SharedComponents::size;
+        }
+
+        /**
+         * @brief Gets the ID of a component type
+         * @tparam Component The component type
+         * @return ComponentID The ID of the component type
+         * @throw std::runtime_error if more than MAX_COMPONENTS types are registered
+         */
+        template<typename Component>
+        static ComponentID id() {
+            using Type = std::remove_cv_t<std::remove_reference_t<Component>>;
+            if constexpr (isShared<Type>()) {
+                return indexIn<Type>(SharedComponents{});
+            } else {
+                static const ComponentID value = nextId();
+                return value;
+            }
+        }
+
+    private:
+        template<typename Component, typename... Components>
+        static constexpr std::size_t indexIn(ComponentList<Components...>) {
+            std::size_t index = 0;
+            ((std::is_same_v<Component, Components> ? false : (++index, true)) && ...);
+            return index;
+        }
+
+        static ComponentID nextId() {
+            static std::atomic<ComponentID> counter{SharedComponents::size};
+            ComponentID value = counter++;
+            if (value >= MAX_COMPONENTS)
+                throw std::runtime_error("Maximum number of component types reached");
+            return value;
+        }
+    };
+
+    /**
+     * @brief Gets the signature bit of a component type
+     */
+    template<typename Component>
+    Signature componentBit() {
+        return Signature{1} << ComponentRegistry::id<Component>();
+    }
+
+    /**
+     * @brief Builds the signature of a set of component types
+     * @tparam Components The component types
+     * @return Signature The mask with the bit of every component type set
+     */
+    template<typename... Components>
+    Signature signatureOf() {
+        return (Signature{0} | ... | componentBit<Components>());
+    }
+
+    /**
+     * @brief Checks if a component type is a tag
+     * @details Tags are empty types: they carry no data, the EntityManager keeps them as one bit
+     * per entity instead of an archetype column.
+     */
+    template<typename Component>
+    constexpr bool isTag = std::is_empty_v<std::remove_cv_t<Component>>;
+}
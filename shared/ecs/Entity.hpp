@@ -1,6 +1,34 @@
+#pragma once
 #include <cstddef>
+#include <cstdint>
 
 /**
  * @brief Entity ID type
  */
-using EntityID = std::size_t;
\ No newline at end of file
+using EntityID = std::size_t;
+
+/**
+ * @brief Value used for "no entity"
+ */
+constexpr EntityID INVALID_ENTITY = static_cast<EntityID>(-1);
+
+/**
+ * @brief Generation of an entity ID, incremented every time the ID is destroyed
+ */
+using EntityGeneration = std::uint32_t;
+
+/**
+ * @struct EntityHandle
+ * @brief Reference to an entity that can be kept across ticks
+ *
+ * @details An EntityID is reused as soon as its entity is destroyed, so a stored ID may end up
+ * naming an unrelated entity. A handle also records the generation of the ID when it was taken:
+ * EntityManager::isValid() compares it with the current generation to tell if the entity is
+ * still the same one.
+ */
+struct EntityHandle {
+    EntityID id = INVALID_ENTITY; ///< Index of the entity
+    EntityGeneration generation = 0; ///< Generation of the index when the handle was taken
+
+    bool operator==(const EntityHandle& other) const = default;
+};
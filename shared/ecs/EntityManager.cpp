@@ -5,37 +5,363 @@
 ** EntityManager
 */
 #include "EntityManager.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
 
 namespace rtype {
     EntityManager::EntityManager() {
-        availableEntities.reserve(MAX_ENTITIES);
-        for (EntityID entity = 0; entity < MAX_ENTITIES; ++entity) {
-            availableEntities.push_back(entity);
-        }
+        reset();
     }
 
     EntityID EntityManager::createEntity() {
-        if (availableEntities.empty()) {
+        while (!availableEntities.empty()) {
+            EntityID id = availableEntities.back();
+            availableEntities.pop_back();
+            if (record(id).archetype == nullptr) {
+                ensureAlive(id);
+                return id;
+            }
+        }
+        // Skip IDs made alive directly by addComponent (the client mirrors server IDs)
+        while (nextEntity < _capacity && record(nextEntity).archetype != nullptr)
+            ++nextEntity;
+        if (nextEntity >= MAX_ENTITIES) {
                 throw std::runtime_error("Maximum number of entities reached");
         }
-        EntityID id = availableEntities.back();
-        availableEntities.pop_back();
+        EntityID id = nextEntity++;
+        ensureAlive(id);
         return id;
     }
 
+    EntityID EntityManager::reserveIds(std::size_t count) {
+        while (nextEntity < _capacity && record(nextEntity).archetype != nullptr)
+            ++nextEntity;
+        if (count > MAX_ENTITIES - nextEntity)
+            throw std::runtime_error("Maximum number of entities reached");
+        const EntityID first = nextEntity;
+        nextEntity += count;
+        _firstFreeId = nextEntity;
+        return first;
+    }
+
     void EntityManager::destroyEntity(EntityID entity) {
-        resetEntityComponents(entity);
+        if (entity >= _capacity || record(entity).archetype == nullptr)
+            return;
+        EntityRecord& destroyed = record(entity);
+        clearTags(destroyed, entity);
+        destroyed.archetype->destroyRow(destroyed.row);
+        EntityID moved = destroyed.archetype->fillHole(destroyed.row);
+        if (moved != INVALID_ENTITY)
+            record(moved).row = destroyed.row;
+        destroyed = EntityRecord{nullptr, 0, 0, destroyed.generation + 1};
         availableEntities.push_back(entity);
     }
 
+    void EntityManager::resetEntityComponents(EntityID entity) {
+        if (entity >= _capacity || record(entity).signature == 0)
+            return;
+        clearTags(record(entity), entity);
+        moveEntity(entity, *_emptyArchetype);
+    }
+
     void EntityManager::reset() {
-        _components.clear();
+        // Archetypes stay registered in the views, only their rows are destroyed
+        for (Archetype* archetype : _archetypeList)
+            archetype->clear();
+        if (_emptyArchetype == nullptr)
+            _emptyArchetype = &getArchetype({});
+        for (auto& tag : _tags)
+            tag.clear();
+        for (auto& page : _recordPages) {
+            for (std::size_t i = 0; i < ENTITY_PAGE_SIZE; ++i)
+                page[i] = EntityRecord{nullptr, 0, 0, page[i].generation + 1};
+        }
         availableEntities.clear();
-        availableEntities.reserve(MAX_ENTITIES);
-        for (EntityID entity = 0; entity < MAX_ENTITIES; ++entity) {
-            availableEntities.push_back(entity);
+        nextEntity = _firstFreeId;
+    }
+
+    EntityManager::EntityRecord& EntityManager::ensureAlive(EntityID entity) {
+        if (entity >= MAX_ENTITIES)
+            throw std::out_of_range("Entity " + std::to_string(entity) + " exceeds MAX_ENTITIES");
+        growTo(entity);
+        EntityRecord& alive = record(entity);
+        if (alive.archetype == nullptr) {
+            alive.archetype = _emptyArchetype;
+            alive.row = _emptyArchetype->push(entity);
+        }
+        return alive;
+    }
+
+    void EntityManager::growTo(EntityID entity) {
+        while (entity >= _capacity) {
+            _recordPages.push_back(std::make_unique<EntityRecord[]>(ENTITY_PAGE_SIZE));
+            _capacity += ENTITY_PAGE_SIZE;
+        }
+    }
+
+    Archetype& EntityManager::getArchetype(std::vector<ComponentInfo> components) {
+        Signature key = 0;
+        for (const auto& component : components)
+            key |= Signature{1} << component.id;
+
+        auto it = _archetypes.find(key);
+        if (it != _archetypes.end())
+            return *it->second;
+        auto archetype = std::make_unique<Archetype>(std::move(components), &_memory);
+        Archetype* ptr = archetype.get();
+        _archetypes.emplace(key, std::move(archetype));
+        _archetypeList.push_back(ptr);
+        for (auto& [mask, view] : _views) {
+            if (ptr->matches(mask))
+                view->archetypes.push_back(ptr);
+        }
+        return *ptr;
+    }
+
+    ViewData& EntityManager::registerView(Signature mask) {
+        std::lock_guard<std::mutex> lock(_viewsMutex);
+        auto it = _views.find(mask);
+        if (it != _views.end())
+            return *it->second;
+        auto view = std::make_unique<ViewData>();
+        view->mask = mask;
+        view->tick = &_tick;
+        for (Archetype* archetype : _archetypeList) {
+            if (archetype->matches(mask))
+                view->archetypes.push_back(archetype);
+        }
+        return *_views.emplace(mask, std::move(view)).first->second;
+    }
+
+    Archetype& EntityManager::archetypeWith(Archetype& from, const ComponentInfo& added) {
+        if (from.addEdges[added.id] != nullptr)
+            return *from.addEdges[added.id];
+        std::vector<ComponentInfo> components = from.components();
+        components.push_back(added);
+        Archetype& target = getArchetype(std::move(components));
+        from.addEdges[added.id] = &target;
+        target.removeEdges[added.id] = &from;
+        return target;
+    }
+
+    Archetype& EntityManager::archetypeWithout(Archetype& from, ComponentID removed) {
+        if (from.removeEdges[removed] != nullptr)
+            return *from.removeEdges[removed];
+        std::vector<ComponentInfo> components;
+        for (const auto& component : from.components()) {
+            if (component.id != removed)
+                components.push_back(component);
+        }
+        Archetype& target = getArchetype(std::move(components));
+        from.removeEdges[removed] = &target;
+        target.addEdges[removed] = &from;
+        return target;
+    }
+
+    void EntityManager::moveEntity(EntityID entity, Archetype& target) {
+        EntityRecord& moving = record(entity);
+        Archetype& source = *moving.archetype;
+        if (&source == &target)
+            return;
+        std::size_t row = target.push(entity);
+
+        for (std::size_t column = 0; column < source.components().size(); ++column) {
+            const ComponentInfo& component = source.components()[column];
+            std::size_t targetColumn = target.columnOf(component.id);
+            if (targetColumn != target.components().size()) {
+                component.moveConstruct(target.at(targetColumn, row), source.at(column, moving.row));
+                target.versionAt(targetColumn, row) = source.versionAt(column, moving.row);
+            } else
+                component.destroy(source.at(column, moving.row));
+        }
+        EntityID moved = source.fillHole(moving.row);
+        if (moved != INVALID_ENTITY)
+            record(moved).row = moving.row;
+        moving.archetype = &target;
+        moving.row = row;
+        moving.signature = target.signature() | (moving.signature & ~source.signature());
+    }
+
+    void EntityManager::clearTags(EntityRecord& record, EntityID entity) {
+        for (Signature tags = record.signature & ~record.archetype->signature(); tags != 0; tags &= tags - 1)
+            _tags[std::countr_zero(tags)].reset(entity);
+        record.signature = record.archetype->signature();
+    }
+
+    void EntityManager::saveSnapshot(std::vector<uint8_t>& out) const {
+        using namespace snapshot;
+        std::size_t size = align(sizeof(SnapshotHeader)) + align(availableEntities.size() * sizeof(EntityID))
+            + align(_capacity * sizeof(EntityGeneration));
+        std::uint64_t archetypeCount = 0;
+
+        for (const Archetype* archetype : _archetypeList) {
+            if (archetype->size() == 0)
+                continue;
+            if (archetype->signature() >> SharedComponents::size)
+                throw std::runtime_error("Only shared components can be saved in a snapshot");
+            size += align(sizeof(ArchetypeSection)) + align(archetype->size() * sizeof(EntityID));
+            for (const auto& component : archetype->components())
+                size += align(archetype->size() * component.size) + align(archetype->size() * sizeof(Tick));
+            archetypeCount++;
+        }
+        for (ComponentID id = SharedComponents::size; id < MAX_COMPONENTS; ++id) {
+            if (!_tags[id].empty())
+                throw std::runtime_error("Only shared components can be saved in a snapshot");
+        }
+        const std::size_t tagWords = (_capacity + 63) / 64;
+        size += std::popcount(sharedTags()) * align(tagWords * sizeof(std::uint64_t));
+        out.assign(size, 0);
+
+        uint8_t* cursor = out.data();
+        auto write = [&cursor](const void* data, std::size_t bytes) {
+            if (bytes != 0)
+                std::memcpy(cursor, data, bytes);
+            cursor += align(bytes);
+        };
+        SnapshotHeader header{SNAPSHOT_MAGIC, SNAPSHOT_VERSION, schemaHash(), nextEntity, availableEntities.size(),
+            _capacity, archetypeCount, _tick, 0};
+        write(&header, sizeof(header));
+        write(availableEntities.data(), availableEntities.size() * sizeof(EntityID));
+        for (std::size_t entity = 0; entity < _capacity; ++entity)
+            std::memcpy(cursor + entity * sizeof(EntityGeneration), &findRecord(entity)->generation, sizeof(EntityGeneration));
+        cursor += align(_capacity * sizeof(EntityGeneration));
+
+        for (const Archetype* archetype : _archetypeList) {
+            if (archetype->size() == 0)
+                continue;
+            ArchetypeSection section{archetype->signature(), archetype->size()};
+            write(&section, sizeof(section));
+            for (std::size_t chunk = 0; chunk < archetype->chunkCount(); ++chunk)
+                std::memcpy(cursor + chunk * archetype->chunkCapacity() * sizeof(EntityID), archetype->entities(chunk),
+                    archetype->chunkSize(chunk) * sizeof(EntityID));
+            cursor += align(archetype->size() * sizeof(EntityID));
+
+            for (std::size_t column = 0; column < archetype->components().size(); ++column) {
+                const std::size_t componentSize = archetype->components()[column].size;
+                for (std::size_t chunk = 0; chunk < archetype->chunkCount(); ++chunk)
+                    std::memcpy(cursor + chunk * archetype->chunkCapacity() * componentSize,
+                        archetype->at(column, chunk * archetype->chunkCapacity()), archetype->chunkSize(chunk) * componentSize);
+                cursor += align(archetype->size() * componentSize);
+                for (std::size_t chunk = 0; chunk < archetype->chunkCount(); ++chunk)
+                    std::memcpy(cursor + chunk * archetype->chunkCapacity() * sizeof(Tick), archetype->versions(chunk, column),
+                        archetype->chunkSize(chunk) * sizeof(Tick));
+                cursor += align(archetype->size() * sizeof(Tick));
+            }
+        }
+
+        for (Signature tags = sharedTags(); tags != 0; tags &= tags - 1) {
+            const auto& words = _tags[std::countr_zero(tags)].words();
+            if (!words.empty())
+                std::memcpy(cursor, words.data(), std::min(words.size(), tagWords) * sizeof(std::uint64_t));
+            cursor += align(tagWords * sizeof(std::uint64_t));
+        }
+    }
+
+    void EntityManager::loadSnapshot(const std::vector<uint8_t>& data) {
+        using namespace snapshot;
+        std::size_t offset = 0;
+        auto take = [&data, &offset](std::size_t bytes) {
+            if (bytes > data.size() || offset + bytes > data.size())
+                throw std::runtime_error("Truncated snapshot");
+            const uint8_t* part = data.data() + offset;
+            offset += align(bytes);
+            return part;
+        };
+
+        SnapshotHeader header;
+        std::memcpy(&header, take(sizeof(header)), sizeof(header));
+        if (header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION)
+            throw std::runtime_error("Not a snapshot or unsupported snapshot version");
+        if (header.schemaHash != schemaHash())
+            throw std::runtime_error("Snapshot was written with other components");
+        if (header.recordCount > MAX_ENTITIES || header.nextEntity > MAX_ENTITIES || header.freeCount > MAX_ENTITIES)
+            throw std::runtime_error("Corrupted snapshot");
+
+        reset();
+        try {
+            const uint8_t* freeIds = take(header.freeCount * sizeof(EntityID));
+            availableEntities.resize(header.freeCount);
+            if (header.freeCount != 0)
+                std::memcpy(availableEntities.data(), freeIds, header.freeCount * sizeof(EntityID));
+            nextEntity = header.nextEntity;
+            _tick = std::max(_tick, header.tick);
+
+            const uint8_t* generations = take(header.recordCount * sizeof(EntityGeneration));
+            if (header.recordCount != 0)
+                growTo(header.recordCount - 1);
+            for (std::size_t entity = 0; entity < header.recordCount; ++entity)
+                std::memcpy(&record(entity).generation, generations + entity * sizeof(EntityGeneration), sizeof(EntityGeneration));
+
+            for (std::uint64_t i = 0; i < header.archetypeCount; ++i) {
+                ArchetypeSection section;
+                std::memcpy(&section, take(sizeof(section)), sizeof(section));
+                if (section.signature >> SharedComponents::size || (section.signature & sharedTags()) || section.count > MAX_ENTITIES)
+                    throw std::runtime_error("Corrupted snapshot");
+
+                std::vector<ComponentInfo> components;
+                for (ComponentID id = 0; id < SharedComponents::size; ++id) {
+                    if (section.signature & (Signature{1} << id))
+                        components.push_back(sharedInfos()[id]);
+                }
+                Archetype& archetype = getArchetype(std::move(components));
+                const std::size_t firstRow = archetype.size();
+
+                const uint8_t* ids = take(section.count * sizeof(EntityID));
+                for (std::size_t row = 0; row < section.count; ++row) {
+                    EntityID entity;
+                    std::memcpy(&entity, ids + row * sizeof(EntityID), sizeof(EntityID));
+                    if (entity >= MAX_ENTITIES)
+                        throw std::runtime_error("Corrupted snapshot");
+                    growTo(entity);
+                    EntityRecord& restored = record(entity);
+                    if (restored.archetype != nullptr)
+                        throw std::runtime_error("Corrupted snapshot");
+                    restored.archetype = &archetype;
+                    restored.row = archetype.push(entity);
+                    restored.signature = archetype.signature();
+                }
+
+                for (std::size_t column = 0; column < archetype.components().size(); ++column) {
+                    const std::size_t componentSize = archetype.components()[column].size;
+                    const uint8_t* values = take(section.count * componentSize);
+                    const uint8_t* versions = take(section.count * sizeof(Tick));
+                    // Copy the run of rows of each chunk at once
+                    for (std::size_t copied = 0; copied < section.count;) {
+                        std::size_t row = firstRow + copied;
+                        std::size_t run = std::min<std::size_t>(archetype.chunkCapacity() - row % archetype.chunkCapacity(), section.count - copied);
+                        std::memcpy(archetype.at(column, row), values + copied * componentSize, run * componentSize);
+                        std::memcpy(&archetype.versionAt(column, row), versions + copied * sizeof(Tick), run * sizeof(Tick));
+                        copied += run;
+                    }
+                }
+            }
+
+            // createEntity trusts the free list, its IDs must name dead records
+            for (EntityID entity : availableEntities) {
+                if (entity >= header.recordCount || record(entity).archetype != nullptr)
+                    throw std::runtime_error("Corrupted snapshot");
+            }
+
+            const std::size_t tagWords = (header.recordCount + 63) / 64;
+            for (Signature tags = sharedTags(); tags != 0; tags &= tags - 1) {
+                const ComponentID id = std::countr_zero(tags);
+                const uint8_t* words = take(tagWords * sizeof(std::uint64_t));
+                for (std::size_t word = 0; word < tagWords; ++word) {
+                    std::uint64_t bits;
+                    std::memcpy(&bits, words + word * sizeof(std::uint64_t), sizeof(bits));
+                    for (; bits != 0; bits &= bits - 1) {
+                        const EntityID entity = static_cast<EntityID>(word * 64 + std::countr_zero(bits));
+                        if (entity >= header.recordCount || record(entity).archetype == nullptr)
+                            throw std::runtime_error("Corrupted snapshot");
+                        _tags[id].set(entity);
+                        record(entity).signature |= Signature{1} << id;
+                    }
+                }
+            }
+        } catch (...) {
+            reset();
+            throw;
         }
-        nextEntity = 1;
-        NbEntities = 1;
     }
-}
\ No newline at end of file
+}
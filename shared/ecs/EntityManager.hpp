@@ -1,21 +1,37 @@
 #pragma once
 #include "Entity.hpp"
-#include "SparseArray.hpp"
+#include "Archetype.hpp"
 #include "Component.hpp"
-#include "IComponent.hpp"
+#include "ComponentRegistry.hpp"
+#include "View.hpp"
+#include "Snapshot.hpp"
+#include "TagSet.hpp"
 #include <unordered_map>
-#include <typeindex>
+#include <tuple>
+#include <utility>
 #include <iostream>
+#include <array>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <type_traits>
 /**
  * @brief EntityManager class
  * @details This class is used to manage the entities and their components
  */
 namespace rtype {
     /**
-     * @brief Maximum number of entities that can exist simultaneously
+     * @brief Number of entity records allocated at once when the entity table grows
      */
-    constexpr size_t MAX_ENTITIES = 1000;
+    constexpr size_t ENTITY_PAGE_SIZE = 1024;
+    /**
+     * @brief Upper bound on entity IDs, pages of records are only allocated when reached
+     */
+    constexpr size_t MAX_ENTITIES = 1 << 20;
     /**
      * @brief Maximum number of enemies that can exist simultaneously
      */
@@ -24,8 +40,21 @@ namespace rtype {
      * @class EntityManager
      * @brief Manages entities and their components in an Entity Component System (ECS)
      *
-     * @details The EntityManager is responsible for creating and destroying entities,
-     * managing their components, and providing access to components through a sparse array system.
+     * @details The EntityManager is responsible for creating and destroying entities and
+     * managing their components. Components are stored by archetype: entities owning the same
+     * set of components share packed chunks, so iterating a set of components only visits
+     * live entities that own all of them. Each entity also keeps its Signature, so membership
+     * tests are a single mask compare.
+     *
+     * Every component value carries the tick of its last change. Mutable access (addComponent,
+     * non-const getComponent, forEach and views over non-const types) stamps the current tick;
+     * asking for a const type (getComponent<const Position>) only reads. advanceTick() starts a
+     * new tick, so "changed since tick N" queries see what happened after N.
+     *
+     * Tags (empty component types such as Wall) have no column: each tag type is a dense TagSet
+     * indexed by entity ID, and its bit is set in the entity Signature. Adding or removing a tag
+     * never moves the entity, hasComponent works the same, and tagged<Wall>() iterates every
+     * wall word by word. Views only cover components with data.
      */
     class EntityManager {
     public:
@@ -33,74 +62,235 @@ namespace rtype {
         ~EntityManager() = default;
         /**
          * @brief Creates a new entity
+         * @details Reuses the most recently destroyed ID if any, otherwise takes the next unused ID
+         * and grows the entity table by one page when needed. Existing records and components
+         * never move when the table grows.
          * @return EntityID The ID of the newly created entity
          * @throw std::runtime_error if maximum number of entities is reached
          */
         EntityID createEntity();
+        /**
+         * @brief Reserves a range of IDs that createEntity will never hand out
+         * @details For entities living outside the manager, such as the projectiles of a
+         * ProjectilePool, whose IDs must not collide with the ones of the manager (the client
+         * mirrors both in one ID space). The range starts at the lowest ID never handed out, and
+         * stays reserved after reset().
+         * @param count The number of IDs to reserve
+         * @return EntityID The first reserved ID
+         * @throw std::runtime_error if maximum number of entities is reached
+         */
+        EntityID reserveIds(std::size_t count);
         /**
          * @brief Resets the entire entity manager
-         * @details Clears all components and resets entity counter to initial state
+         * @details Clears all components and resets entity counter to initial state. Generations
+         * are kept and incremented, so handles taken before the reset are all invalid after it.
+         * Archetypes, their chunks and the entity table are kept: refilling the world after a
+         * reset reuses the same memory instead of allocating it again.
          */
         void reset();
         /**
          * @brief Destroys an entity and removes all its components
+         * @details Increments the generation of the ID, so every handle taken on the entity
+         * becomes invalid before the ID is reused.
          * @param entity The ID of the entity to destroy
          */
         void destroyEntity(EntityID entity);
         /**
-         * @brief Gets the sparse array of components of a specific type
-         * @tparam Component The type of component to get
-         * @return SparseArray<Component>& Reference to the sparse array of components
+         * @brief Gets a handle on an entity that can be kept across ticks
+         * @param entity The entity ID
+         * @return EntityHandle The ID paired with its current generation
          */
-        template<typename Component>
-        SparseArray<Component>& getComponents() {
-            auto typeIndex = std::type_index(typeid(Component));
-            auto it = _components.find(typeIndex);
-            if (it == _components.end()) {
-                auto sparseArray = std::make_unique<SparseArray<Component>>();
-                auto ptr = sparseArray.get();
-                _components[typeIndex] = std::move(sparseArray);
-                return *ptr;
-            }
-            return *static_cast<SparseArray<Component>*>(_components[typeIndex].get());
+        EntityHandle getHandle(EntityID entity) const {
+            const EntityRecord* record = findRecord(entity);
+            return {entity, record ? record->generation : 0};
+        }
+        /**
+         * @brief Checks if a handle still refers to a living entity
+         * @details The check is O(1): the entity must be alive and its ID must not have been
+         * destroyed since the handle was taken.
+         * @param handle The handle to check
+         * @return bool True if the entity of the handle is still alive
+         */
+        bool isValid(EntityHandle handle) const {
+            const EntityRecord* record = findRecord(handle.id);
+            return record && record->archetype != nullptr && record->generation == handle.generation;
+        }
+        /**
+         * @brief Calls a function for every entity that has the specified components
+         * @details The function receives the entity ID followed by a reference to each component.
+         * Entities must not be created or destroyed, nor components added or removed, during the call.
+         * @tparam Components Parameter pack of component types to iterate
+         * @param function Callable taking (EntityID, Components&...)
+         */
+        template<typename... Components, typename Function>
+        void forEach(Function&& function) {
+            view<Components...>().each(std::forward<Function>(function));
+        }
+
+        /**
+         * @brief Gets the persistent view of the entities that have the specified components
+         * @details The view is registered on first use and then maintained incrementally as
+         * archetypes are created, so later calls are a single lookup and iterating the view
+         * only visits matching entities.
+         * @tparam Components Parameter pack of component types required by the view
+         * @return View<Components...> Handle on the view, valid for the lifetime of the manager
+         */
+        template<typename... Components>
+        View<Components...> view() {
+            static_assert(sizeof...(Components) > 0, "A view needs at least one component type");
+            return View<Components...>(registerView(signatureOf<Components...>()));
         }
 
         /**
          * @brief Gets all entities that have the specified components
+         * @details Allocates the result, prefer the overload filling a reused vector every tick.
          * @tparam Components Parameter pack of component types to check for
          * @return std::vector<EntityID> Vector of entity IDs that have all specified components
          */
         template<typename... Components>
         std::vector<EntityID> getEntitiesWithComponents() const {
             std::vector<EntityID> result;
+            getEntitiesWithComponents<Components...>(result);
+            return result;
+        }
+        /**
+         * @brief Gets all entities that have the specified components into a reused vector
+         * @details The vector is cleared first and keeps its capacity, so it stops allocating
+         * once it has grown to the largest result.
+         * @tparam Components Parameter pack of component types to check for
+         * @param result Receives the entity IDs that have all specified components
+         */
+        template<typename... Components>
+        void getEntitiesWithComponents(std::vector<EntityID>& result) const {
+            static_assert((!isTag<Components> && ...), "Tags are not stored in archetypes, iterate them with tagged");
+            const Signature mask = signatureOf<Components...>();
 
-            for (EntityID entity = 0; entity < MAX_ENTITIES; ++entity) {
-                if ((hasComponent<Components>(entity) && ...)) {
-                    result.push_back(entity);
+            result.clear();
+            for (const Archetype* archetype : _archetypeList) {
+                if (!archetype->matches(mask))
+                    continue;
+                for (std::size_t chunk = 0; chunk < archetype->chunkCount(); ++chunk) {
+                    const EntityID* ids = archetype->entities(chunk);
+                    result.insert(result.end(), ids, ids + archetype->chunkSize(chunk));
                 }
             }
-
-            return result;
         }
         /**
          * @brief Adds a component to an entity
+         * @details Moves the entity to the archetype matching its new set of components.
+         * If the entity already has the component, it is overwritten. Adding a tag only sets its bit.
          * @tparam Component The type of component to add
          * @param entity The entity ID to add the component to
          * @param component The component instance to add
          */
         template<typename Component>
         void addComponent(EntityID entity, Component component) {
-            getComponents<Component>().insert_at(entity, component);
+            EntityRecord& record = ensureAlive(entity);
+            ComponentID id = ComponentRegistry::id<Component>();
+
+            if constexpr (isTag<Component>) {
+                _tags[id].set(entity);
+                record.signature |= Signature{1} << id;
+                return;
+            }
+            if (record.signature & (Signature{1} << id)) {
+                std::size_t column = record.archetype->columnOf(id);
+                *static_cast<Component*>(record.archetype->at(column, record.row)) = std::move(component);
+                record.archetype->versionAt(column, record.row) = _tick;
+                return;
+            }
+            Archetype& target = archetypeWith(*record.archetype, ComponentInfo::of<Component>());
+            moveEntity(entity, target);
+            std::size_t column = target.columnOf(id);
+            new (target.at(column, record.row)) Component(std::move(component));
+            target.versionAt(column, record.row) = _tick;
+        }
+        /**
+         * @brief Removes a component from an entity
+         * @tparam Component The type of component to remove
+         * @param entity The entity ID to remove the component from
+         */
+        template<typename Component>
+        void removeComponent(EntityID entity) {
+            if (!hasComponent<Component>(entity))
+                return;
+            if constexpr (isTag<Component>) {
+                _tags[ComponentRegistry::id<Component>()].reset(entity);
+                record(entity).signature &= ~componentBit<Component>();
+            } else
+                moveEntity(entity, archetypeWithout(*record(entity).archetype, ComponentRegistry::id<Component>()));
         }
         /**
          * @brief Gets a component from an entity
+         * @details Marks the component as changed at the current tick, unless Component is a
+         * const type.
          * @tparam Component The type of component to get
          * @param entity The entity ID to get the component from
          * @return Component& Reference to the requested component
+         * @throw std::out_of_range if the entity does not have the component
          */
         template<typename Component>
         Component& getComponent(EntityID entity) {
-            return *getComponents<Component>()[entity];
+            const EntityManager& self = *this;
+            Component& component = const_cast<Component&>(self.getComponent<Component>(entity));
+            if constexpr (!std::is_const_v<Component>)
+                markChanged<Component>(entity);
+            return component;
+        }
+        /**
+         * @brief Gets a component from an entity
+         * @tparam Component The type of component to get
+         * @param entity The entity ID to get the component from
+         * @return const Component& Reference to the requested component
+         * @throw std::out_of_range if the entity does not have the component
+         */
+        template<typename Component>
+        const Component& getComponent(EntityID entity) const {
+            static_assert(!isTag<Component>, "Tags have no data, test them with hasComponent");
+            if (!hasComponent<Component>(entity))
+                throw std::out_of_range("Entity " + std::to_string(entity) + " has no such component");
+            const EntityRecord& record = *findRecord(entity);
+            return *static_cast<const Component*>(record.archetype->at(record.archetype->columnOf(ComponentRegistry::id<Component>()), record.row));
+        }
+        /**
+         * @brief Gets the current tick, stamped on every component changed from now on
+         */
+        Tick currentTick() const { return _tick; }
+        /**
+         * @brief Starts a new tick
+         * @details Changes made before the call are seen by changedSince(e, tick) with the
+         * tick returned by currentTick() before the call, the later ones are not.
+         */
+        void advanceTick() { ++_tick; }
+        /**
+         * @brief Marks a component of an entity as changed at the current tick
+         * @details Only needed after writing through a pointer that is not tracked, such as
+         * the columns given by View::eachChunk.
+         * @tparam Component The type of the changed component
+         * @param entity The entity ID
+         */
+        template<typename Component>
+        void markChanged(EntityID entity) {
+            static_assert(!isTag<Component>, "Tags have no version");
+            if (!hasComponent<Component>(entity))
+                return;
+            EntityRecord& changed = record(entity);
+            changed.archetype->versionAt(changed.archetype->columnOf(ComponentRegistry::id<Component>()), changed.row) = _tick;
+        }
+        /**
+         * @brief Checks if a component of an entity changed after a tick
+         * @tparam Component The type of component to check
+         * @param entity The entity ID
+         * @param since The last tick already seen by the caller
+         * @return bool True if the entity has the component and it changed after since
+         */
+        template<typename Component>
+        bool changedSince(EntityID entity, Tick since) const {
+            static_assert(!isTag<Component>, "Tags have no version");
+            if (!hasComponent<Component>(entity))
+                return false;
+            const EntityRecord& checked = *findRecord(entity);
+            return checked.archetype->versionAt(checked.archetype->columnOf(ComponentRegistry::id<Component>()), checked.row) > since;
         }
         /**
          * @brief Checks if an entity has a specific component
@@ -110,11 +300,41 @@ namespace rtype {
          */
         template<typename Component>
         bool hasComponent(EntityID entity) const {
-            auto typeIndex = std::type_index(typeid(Component));
-            auto it = _components.find(typeIndex);
-            if (it == _components.end())
-                return false;
-            return static_cast<const SparseArray<Component>*>(it->second.get())->operator[](entity).has_value();
+            const EntityRecord* record = findRecord(entity);
+            return record && (record->signature & componentBit<Component>());
+        }
+        /**
+         * @brief Gets every entity owning a tag
+         * @details The set must not be iterated while the tag is added or removed, defer these
+         * changes with a CommandBuffer.
+         * @tparam Tag The tag type
+         * @return const TagSet& The entities owning the tag, by increasing ID
+         */
+        template<typename Tag>
+        const TagSet& tagged() const {
+            static_assert(isTag<Tag>, "Only tags are stored in a TagSet, use view for components with data");
+            return _tags[ComponentRegistry::id<Tag>()];
+        }
+        /**
+         * @brief Checks if an entity has all the specified components
+         * @tparam Components Parameter pack of component types to check for
+         * @param entity The entity ID to check
+         * @return bool True if the entity has every component, false otherwise
+         */
+        template<typename... Components>
+        bool hasComponents(EntityID entity) const {
+            const Signature mask = signatureOf<Components...>();
+            const EntityRecord* record = findRecord(entity);
+            return record && (record->signature & mask) == mask;
+        }
+        /**
+         * @brief Gets the signature of an entity
+         * @param entity The entity ID
+         * @return Signature The bitset of the components owned by the entity, 0 if it is not alive
+         */
+        Signature getSignature(EntityID entity) const {
+            const EntityRecord* record = findRecord(entity);
+            return record ? record->signature : 0;
         }
         /**
          * @brief Checks the enemy type of an entity
@@ -124,17 +344,10 @@ namespace rtype {
          */
         template<typename Component>
         int hasTypeEnemy(EntityID entity) const {
-            auto typeIndex = std::type_index(typeid(Component));
-            auto it = _components.find(typeIndex);
-
-            if (it == _components.end())
+            if (!hasComponent<Component>(entity))
                 return 0;
 
-            const auto& sparseArray = *static_cast<const SparseArray<Component>*>(it->second.get());
-            if (!sparseArray[entity].has_value())
-                return 0;
-
-            const auto& enemyComponent = sparseArray[entity].value();
+            const auto& enemyComponent = getComponent<Component>(entity);
 
             if (enemyComponent.level == 1)
                 return 2;
@@ -148,20 +361,124 @@ namespace rtype {
          * @brief Removes all components from an entity
          * @param entity The entity ID to reset
          */
-        void resetEntityComponents(EntityID entity) {
-            for (auto& [typeIndex, componentArray] : _components) {
-                if (componentArray) {
-                    componentArray->erase(entity);
-                }
-            }
-        }
+        void resetEntityComponents(EntityID entity);
+        /**
+         * @brief Serializes the whole world into one binary blob
+         * @details Writes every entity with its components and their versions, the free ID list,
+         * the generations and the current tick. Columns are copied chunk by chunk with memcpy.
+         * @see snapshot::SnapshotHeader for the layout
+         * @param out The buffer receiving the snapshot, its capacity is reused
+         * @throw std::runtime_error if an entity owns a component that is not a SharedComponents type
+         */
+        void saveSnapshot(std::vector<uint8_t>& out) const;
+        /**
+         * @brief Replaces the whole world by a snapshot taken with saveSnapshot
+         * @details Views stay valid. The current tick never goes back, but restored versions may be
+         * older than what a consumer of changedSince already saw: resynchronize everything after a restore.
+         * @param data The snapshot
+         * @throw std::runtime_error if the snapshot is truncated, corrupted or written with another schema,
+         * the manager is left empty in that case
+         */
+        void loadSnapshot(const std::vector<uint8_t>& data);
     private:
         /**
-         * @brief Map storing component arrays indexed by their type
+         * @brief Location of an entity in the archetype storage
+         */
+        struct EntityRecord {
+            Archetype* archetype = nullptr; ///< Archetype holding the entity, nullptr if the entity is not alive
+            std::size_t row = 0; ///< Row of the entity inside its archetype
+            Signature signature = 0; ///< Components owned by the entity: archetype->signature() plus its tags
+            EntityGeneration generation = 0; ///< Number of times the ID has been destroyed
+        };
+
+        /**
+         * @brief Gets the record of an entity
+         * @param entity The entity ID
+         * @return const EntityRecord* The record, or nullptr if the ID is beyond the allocated pages
+         */
+        const EntityRecord* findRecord(EntityID entity) const {
+            if (entity >= _capacity)
+                return nullptr;
+            return &_recordPages[entity / ENTITY_PAGE_SIZE][entity % ENTITY_PAGE_SIZE];
+        }
+        /**
+         * @brief Gets the record of an entity whose page is allocated
+         */
+        EntityRecord& record(EntityID entity) {
+            return _recordPages[entity / ENTITY_PAGE_SIZE][entity % ENTITY_PAGE_SIZE];
+        }
+        /**
+         * @brief Gets the record of an entity, making it alive in the empty archetype if needed
+         * @param entity The entity ID
+         * @return EntityRecord& The record of the entity
+         * @throw std::out_of_range if the entity ID is beyond the maximum number of entities
+         */
+        EntityRecord& ensureAlive(EntityID entity);
+        /**
+         * @brief Allocates pages of records until an entity ID fits in the table
+         */
+        void growTo(EntityID entity);
+        /**
+         * @brief Finds or registers the view of a signature
+         * @details Thread safe, systems run by the Scheduler may query views concurrently.
+         * @param mask The components required by the view
+         * @return ViewData& The view, filled with the matching archetypes
+         */
+        ViewData& registerView(Signature mask);
+        /**
+         * @brief Finds or creates the archetype storing exactly the given components
+         * @param components The component types of the archetype
+         * @return Archetype& The matching archetype
+         */
+        Archetype& getArchetype(std::vector<ComponentInfo> components);
+        /**
+         * @brief Finds the archetype reached by adding a component to another archetype
+         */
+        Archetype& archetypeWith(Archetype& from, const ComponentInfo& added);
+        /**
+         * @brief Finds the archetype reached by removing a component from another archetype
          */
-        std::unordered_map<std::type_index, std::unique_ptr<IComponent>> _components;
-        std::vector<EntityID> availableEntities;
-        EntityID nextEntity = 1;
-        int NbEntities = 1;
+        Archetype& archetypeWithout(Archetype& from, ComponentID removed);
+        /**
+         * @brief Moves an entity to another archetype
+         * @details Components shared by both archetypes are moved, the others are destroyed.
+         * Columns only present in the target are left unconstructed.
+         * @param entity The entity to move
+         * @param target The archetype receiving the entity
+         */
+        void moveEntity(EntityID entity, Archetype& target);
+        /**
+         * @brief Removes every tag of an entity
+         */
+        void clearTags(EntityRecord& record, EntityID entity);
+
+        /**
+         * @brief Pools the chunks of every archetype of the world
+         * @details Declared first so it outlives the archetypes. Chunks freed by an archetype go back
+         * to the pool, not to malloc.
+         */
+        std::pmr::unsynchronized_pool_resource _memory{std::pmr::pool_options{0, CHUNK_SIZE}};
+        /**
+         * @brief Archetypes indexed by their signature
+         */
+        std::unordered_map<Signature, std::unique_ptr<Archetype>> _archetypes;
+        std::vector<Archetype*> _archetypeList;
+        /**
+         * @brief Registered views indexed by their signature
+         */
+        std::unordered_map<Signature, std::unique_ptr<ViewData>> _views;
+        std::mutex _viewsMutex; ///< Guards _views against concurrent registerView calls
+        Archetype* _emptyArchetype = nullptr;
+        std::array<TagSet, MAX_COMPONENTS> _tags; ///< Entities owning each tag, indexed by component ID
+        /**
+         * @brief Entity records, allocated by pages of ENTITY_PAGE_SIZE so they never move
+         */
+        std::vector<std::unique_ptr<EntityRecord[]>> _recordPages;
+        std::size_t _capacity = 0;
+        Tick _tick = 1; ///< Current tick, kept across reset() so versions never go back
+        std::vector<EntityID> availableEntities; ///< Destroyed IDs, reused last in first out
+        EntityID nextEntity = 0; ///< Lowest ID never handed out by createEntity
+        EntityID _firstFreeId = 0; ///< First ID after the reserved ranges, where reset() restarts
+
     };
-}
\ No newline at end of file
+}
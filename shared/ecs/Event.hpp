@@ -0,0 +1,31 @@
+#pragma once
+#include "Entity.hpp"
+
+/**
+ * @brief Events emitted by the gameplay code, queued in an EventBus and consumed in batches
+ */
+namespace rtype {
+    /**
+     * @brief An entity died: destroyed by a hit or a pickup, or a player out of lives
+     */
+    struct EntityDied {
+        EntityHandle entity; ///< The entity that died
+        EntityHandle killer; ///< The entity that caused the death, if any
+    };
+    /**
+     * @brief A projectile hit an entity (enemy, player or wall)
+     */
+    struct ProjectileHit {
+        EntityHandle projectile;
+        EntityHandle target;
+        float damage; ///< Damage dealt to the target
+    };
+    /**
+     * @brief A player collected a pickup (health pack)
+     */
+    struct PickupCollected {
+        EntityHandle player;
+        EntityHandle pickup;
+        int amount; ///< Life given to the player
+    };
+}
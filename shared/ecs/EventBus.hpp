@@ -0,0 +1,120 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** EventBus
+*/
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace rtype {
+    /**
+     * @brief Maximum number of event types known by an EventBus
+     */
+    constexpr std::size_t MAX_EVENT_TYPES = 32;
+
+    /**
+     * @class EventBus
+     * @brief Typed queues of the events emitted during a tick
+     *
+     * @details Producers emit events while resolving a pass (collisions, pickups...) instead of
+     * reacting on the spot, consumers read each queue as a batch once the pass is over. Events of
+     * one type are read in the order they were emitted. Every queue keeps its capacity after
+     * clear(), so a bus reused every tick stops allocating.
+     *
+     * An EventBus is not thread safe. Consumers may emit events of other types while reading a
+     * queue; to emit events of the type being read, iterate it by index.
+     */
+    class EventBus {
+    public:
+        /**
+         * @brief Queues an event
+         * @tparam Event The event type
+         * @param event The event
+         */
+        template<typename Event>
+        void emit(Event event) {
+            queue<Event>().push_back(std::move(event));
+        }
+
+        /**
+         * @brief Gets the events of a type emitted since the last clear()
+         * @tparam Event The event type
+         * @return const std::vector<Event>& The events, in emission order
+         */
+        template<typename Event>
+        const std::vector<Event>& read() const {
+            static const std::vector<Event> none;
+            const auto& queue = _queues[eventId<Event>()];
+            return queue ? static_cast<const Queue<Event>&>(*queue).events : none;
+        }
+
+        /**
+         * @brief Checks if no event is queued
+         */
+        bool empty() const {
+            for (const auto& queue : _queues) {
+                if (queue && !queue->empty())
+                    return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Drops every queued event, keeping the storage
+         */
+        void clear() {
+            for (auto& queue : _queues) {
+                if (queue)
+                    queue->clear();
+            }
+        }
+
+    private:
+        /**
+         * @brief Type-erased queue of events
+         */
+        struct IQueue {
+            virtual ~IQueue() = default;
+            virtual bool empty() const = 0;
+            virtual void clear() = 0;
+        };
+
+        template<typename Event>
+        struct Queue : IQueue {
+            std::vector<Event> events;
+            bool empty() const override { return events.empty(); }
+            void clear() override { events.clear(); }
+        };
+
+        template<typename Event>
+        std::vector<Event>& queue() {
+            auto& queue = _queues[eventId<Event>()];
+            if (!queue)
+                queue = std::make_unique<Queue<Event>>();
+            return static_cast<Queue<Event>&>(*queue).events;
+        }
+
+        template<typename Event>
+        static std::size_t eventId() {
+            static const std::size_t id = nextEventId();
+            return id;
+        }
+
+        static std::size_t nextEventId() {
+            static std::atomic<std::size_t> counter{0};
+            std::size_t value = counter++;
+            if (value >= MAX_EVENT_TYPES)
+                throw std::runtime_error("Maximum number of event types reached");
+            return value;
+        }
+
+        std::array<std::unique_ptr<IQueue>, MAX_EVENT_TYPES> _queues;
+    };
+}
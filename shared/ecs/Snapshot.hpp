@@ -0,0 +1,107 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** Snapshot
+*/
+#pragma once
+#include "Archetype.hpp"
+#include "ComponentRegistry.hpp"
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @brief Binary layout of an EntityManager snapshot
+ *
+ * @details A snapshot is one contiguous blob, in host byte order:
+ * - a SnapshotHeader,
+ * - the free ID list (EntityID[freeCount]),
+ * - the generation of every entity ID (EntityGeneration[recordCount]),
+ * - one section per non-empty archetype: an ArchetypeSection, the entity IDs (EntityID[count]),
+ *   then for each component of the archetype, by increasing ID, the values (count * size bytes)
+ *   followed by their versions (Tick[count]),
+ * - for each shared tag, by increasing ID, the entities owning it as a bitset
+ *   (uint64_t[(recordCount + 63) / 64], bit N of word W is entity W * 64 + N).
+ * Every part starts on a SNAPSHOT_ALIGN boundary, so sections can be copied with memcpy.
+ * Only SharedComponents are snapshotted, they are all trivially copyable.
+ */
+namespace rtype::snapshot {
+    constexpr std::uint32_t SNAPSHOT_MAGIC = 0x4E535452; ///< "RTSN"
+    constexpr std::uint32_t SNAPSHOT_VERSION = 2; ///< Bump when the meaning of a shared component changes
+    constexpr std::size_t SNAPSHOT_ALIGN = 8;
+
+    struct SnapshotHeader {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint64_t schemaHash; ///< @see schemaHash()
+        std::uint64_t nextEntity;
+        std::uint64_t freeCount;
+        std::uint64_t recordCount;
+        std::uint64_t archetypeCount;
+        std::uint32_t tick;
+        std::uint32_t padding;
+    };
+
+    struct ArchetypeSection {
+        std::uint64_t signature;
+        std::uint64_t count;
+    };
+
+    /**
+     * @brief Rounds a size up to the next section boundary
+     */
+    constexpr std::size_t align(std::size_t size) {
+        return (size + SNAPSHOT_ALIGN - 1) / SNAPSHOT_ALIGN * SNAPSHOT_ALIGN;
+    }
+
+    template<typename... Components>
+    constexpr std::uint64_t hashOf(ComponentList<Components...>) {
+        static_assert((std::is_trivially_copyable_v<Components> && ...), "Shared components must be trivially copyable");
+        // FNV-1a over the layout of every shared component and of the ID types
+        std::uint64_t hash = 14695981039346656037ull;
+        const std::uint64_t values[] = {SNAPSHOT_VERSION, sizeof(EntityID), sizeof(Tick), sizeof(Components)..., alignof(Components)...,
+            isTag<Components>...};
+        for (std::uint64_t value : values) {
+            hash ^= value;
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Hash of the snapshot schema: format version, list, sizes, alignments and tags of the shared components
+     * @details A snapshot is only restored by a build with the same hash.
+     */
+    constexpr std::uint64_t schemaHash() {
+        return hashOf(SharedComponents{});
+    }
+
+    template<typename... Components>
+    constexpr Signature tagsOf(ComponentList<Components...>) {
+        Signature mask = 0;
+        Signature bit = 1;
+        ((mask |= isTag<Components> ? bit : 0, bit <<= 1), ...);
+        return mask;
+    }
+
+    /**
+     * @brief Gets the signature of the shared tags, saved as bitsets instead of archetype columns
+     */
+    constexpr Signature sharedTags() {
+        return tagsOf(SharedComponents{});
+    }
+
+    template<typename... Components>
+    std::array<ComponentInfo, sizeof...(Components)> infosOf(ComponentList<Components...>) {
+        return {ComponentInfo::of<Components>()...};
+    }
+
+    /**
+     * @brief Gets the description of every shared component, indexed by component ID
+     */
+    inline const std::array<ComponentInfo, SharedComponents::size>& sharedInfos() {
+        static const auto infos = infosOf(SharedComponents{});
+        return infos;
+    }
+}
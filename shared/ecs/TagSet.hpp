@@ -0,0 +1,152 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** TagSet
+*/
+#pragma once
+#include "Entity.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace rtype {
+    /**
+     * @class TagSet
+     * @brief Dense bitset of the entities owning a tag component, indexed by entity ID
+     *
+     * @details One bit per entity ID, packed in 64-bit words. Membership tests are a single
+     * word load, iteration skips 64 absent entities at a time and visits the others by
+     * increasing ID. Iterating costs one word per 64 IDs up to the highest tagged ID, so code
+     * walking a small tag set in an inner loop should copy what it needs out of it first.
+     */
+    class TagSet {
+    public:
+        /**
+         * @class iterator
+         * @brief Forward iterator over the entity IDs of a TagSet
+         */
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = EntityID;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const EntityID*;
+            using reference = EntityID;
+
+            iterator() = default;
+            iterator(const std::vector<std::uint64_t>* words, std::size_t word) : _words(words), _word(word) {
+                if (_word < _words->size())
+                    _bits = (*_words)[_word];
+                skipEmpty();
+            }
+
+            EntityID operator*() const { return static_cast<EntityID>(_word * 64 + std::countr_zero(_bits)); }
+
+            iterator& operator++() {
+                _bits &= _bits - 1;
+                skipEmpty();
+                return *this;
+            }
+
+            iterator operator++(int) {
+                iterator previous = *this;
+                ++*this;
+                return previous;
+            }
+
+            bool operator==(const iterator& other) const { return _word == other._word && _bits == other._bits; }
+
+        private:
+            void skipEmpty() {
+                while (_bits == 0 && ++_word < _words->size())
+                    _bits = (*_words)[_word];
+                if (_bits == 0)
+                    _word = _words->size();
+            }
+
+            const std::vector<std::uint64_t>* _words = nullptr;
+            std::size_t _word = 0;
+            std::uint64_t _bits = 0;
+        };
+
+        /**
+         * @brief Adds an entity to the set
+         * @return bool True if the entity was not in the set
+         */
+        bool set(EntityID entity) {
+            const std::size_t word = entity / 64;
+            if (word >= _words.size())
+                _words.resize(word + 1, 0);
+            const std::uint64_t bit = std::uint64_t{1} << (entity % 64);
+            if (_words[word] & bit)
+                return false;
+            _words[word] |= bit;
+            _count++;
+            return true;
+        }
+
+        /**
+         * @brief Removes an entity from the set
+         * @return bool True if the entity was in the set
+         */
+        bool reset(EntityID entity) {
+            if (!test(entity))
+                return false;
+            _words[entity / 64] &= ~(std::uint64_t{1} << (entity % 64));
+            _count--;
+            return true;
+        }
+
+        /**
+         * @brief Checks if an entity is in the set
+         */
+        bool test(EntityID entity) const {
+            const std::size_t word = entity / 64;
+            return word < _words.size() && (_words[word] >> (entity % 64)) & 1;
+        }
+
+        /**
+         * @brief Removes every entity, keeping the words allocated
+         */
+        void clear() {
+            std::fill(_words.begin(), _words.end(), 0);
+            _count = 0;
+        }
+
+        /**
+         * @brief Gets the number of entities in the set
+         */
+        std::size_t size() const { return _count; }
+
+        bool empty() const { return _count == 0; }
+
+        /**
+         * @brief Gets the packed bits, bit N of word W is entity W * 64 + N
+         */
+        const std::vector<std::uint64_t>& words() const { return _words; }
+
+        /**
+         * @brief Calls a function for every entity of the set, by increasing ID
+         * @details The set must not be modified during the call.
+         * @param function Callable taking an EntityID
+         */
+        template<typename Function>
+        void forEach(Function&& function) const {
+            for (std::size_t word = 0; word < _words.size(); ++word) {
+                for (std::uint64_t bits = _words[word]; bits != 0; bits &= bits - 1)
+                    function(static_cast<EntityID>(word * 64 + std::countr_zero(bits)));
+            }
+        }
+
+        iterator begin() const { return iterator(&_words, 0); }
+        iterator end() const { return iterator(&_words, _words.size()); }
+
+    private:
+        std::vector<std::uint64_t> _words;
+        std::size_t _count = 0;
+    };
+}
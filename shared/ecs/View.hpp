@@ -0,0 +1,251 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** View
+*/
+#pragma once
+#include "Archetype.hpp"
+#include "ComponentRegistry.hpp"
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rtype {
+    /**
+     * @struct ViewData
+     * @brief Archetypes matching a query, kept up to date by the EntityManager
+     *
+     * @details A ViewData is registered once per signature. Every archetype created afterwards
+     * is tested against the mask and appended if it matches, so a query never rescans the world.
+     */
+    struct ViewData {
+        Signature mask = 0; ///< Components required by the query
+        std::vector<Archetype*> archetypes; ///< Archetypes owning every component of the mask
+        const Tick* tick = nullptr; ///< Current tick of the EntityManager, stamped on mutable access
+    };
+
+    /**
+     * @class View
+     * @brief Persistent query over every entity owning a set of components
+     *
+     * @details A View is a cheap handle on a ViewData owned by the EntityManager: it can be kept
+     * across ticks and stays valid after EntityManager::reset(). Iterating it never allocates.
+     * Like forEach, a View must not be iterated while entities are created or destroyed, or
+     * components added or removed; use collect() to take a snapshot first in that case.
+     *
+     * Iterating with each() marks the components as changed at the current tick. Declare a
+     * component type const (View<const Position>) to only read it and keep its version.
+     * @tparam Components The component types required by the query
+     */
+    template<typename... Components>
+    class View {
+        static_assert((!isTag<Components> && ...), "Tags are not stored in archetypes, iterate them with EntityManager::tagged");
+    public:
+        /**
+         * @class iterator
+         * @brief Forward iterator over the entity IDs of a View
+         */
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = EntityID;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const EntityID*;
+            using reference = EntityID;
+
+            iterator() = default;
+            iterator(const std::vector<Archetype*>* archetypes, std::size_t archetype)
+                : _archetypes(archetypes), _archetype(archetype) {
+                skipEmpty();
+            }
+
+            EntityID operator*() const { return (*_archetypes)[_archetype]->entityAt(_row); }
+
+            iterator& operator++() {
+                if (++_row >= (*_archetypes)[_archetype]->size()) {
+                    ++_archetype;
+                    _row = 0;
+                    skipEmpty();
+                }
+                return *this;
+            }
+
+            iterator operator++(int) {
+                iterator copy = *this;
+                ++*this;
+                return copy;
+            }
+
+            bool operator==(const iterator& other) const {
+                return _archetype == other._archetype && _row == other._row;
+            }
+
+            bool operator!=(const iterator& other) const { return !(*this == other); }
+
+        private:
+            void skipEmpty() {
+                while (_archetype < _archetypes->size() && (*_archetypes)[_archetype]->size() == 0)
+                    ++_archetype;
+            }
+
+            const std::vector<Archetype*>* _archetypes = nullptr;
+            std::size_t _archetype = 0;
+            std::size_t _row = 0;
+        };
+
+        explicit View(ViewData& data) : _data(&data) {}
+
+        iterator begin() const { return iterator(&_data->archetypes, 0); }
+        iterator end() const { return iterator(&_data->archetypes, _data->archetypes.size()); }
+
+        /**
+         * @brief Gets the number of matching entities
+         * @details Costs one addition per matching archetype.
+         */
+        std::size_t size() const {
+            std::size_t count = 0;
+            for (const Archetype* archetype : _data->archetypes)
+                count += archetype->size();
+            return count;
+        }
+
+        /**
+         * @brief Checks if no entity matches the view
+         */
+        bool empty() const {
+            for (const Archetype* archetype : _data->archetypes) {
+                if (archetype->size() != 0)
+                    return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Copies the matching entity IDs into a buffer
+         * @details The buffer is cleared first but keeps its capacity, so a buffer reused every
+         * tick stops allocating once it has grown to the usual number of entities.
+         * @param out The buffer receiving the entity IDs
+         */
+        void collect(std::vector<EntityID>& out) const {
+            out.clear();
+            for (const Archetype* archetype : _data->archetypes) {
+                for (std::size_t chunk = 0; chunk < archetype->chunkCount(); ++chunk) {
+                    const EntityID* ids = archetype->entities(chunk);
+                    out.insert(out.end(), ids, ids + archetype->chunkSize(chunk));
+                }
+            }
+        }
+
+        /**
+         * @brief Copies the IDs of the matching entities changed since a tick into a buffer
+         * @details An entity is changed if any of the view's components was changed after the tick.
+         * @param since The last tick already seen by the caller
+         * @param out The buffer receiving the entity IDs, cleared first
+         */
+        void collectChanged(Tick since, std::vector<EntityID>& out) const {
+            out.clear();
+            for (Archetype* archetype : _data->archetypes)
+                changedInArchetype(*archetype, since, [&out](EntityID entity, const auto&...) { out.push_back(entity); },
+                    std::index_sequence_for<Components...>{}, false);
+        }
+
+        /**
+         * @brief Calls a function for every matching entity
+         * @param function Callable taking (EntityID, Components&...)
+         */
+        template<typename Function>
+        void each(Function&& function) const {
+            for (Archetype* archetype : _data->archetypes)
+                eachInArchetype(*archetype, function, *_data->tick, std::index_sequence_for<Components...>{});
+        }
+
+        /**
+         * @brief Calls a function for every matching entity changed since a tick
+         * @details An entity is changed if any of the view's components was changed after the tick.
+         * @param since The last tick already seen by the caller
+         * @param function Callable taking (EntityID, Components&...)
+         */
+        template<typename Function>
+        void eachChanged(Tick since, Function&& function) const {
+            for (Archetype* archetype : _data->archetypes)
+                changedInArchetype(*archetype, since, function, std::index_sequence_for<Components...>{}, true);
+        }
+
+        /**
+         * @brief Calls a function for every chunk holding matching entities
+         * @details Gives access to whole columns, so a system can run a kernel over a chunk
+         * instead of one entity at a time. Every entity of a chunk has the same signature.
+         * Writes through the raw columns are not tracked, report them with the Tick columns
+         * passed to the function (one per component, set the row to the current tick).
+         * @param function Callable taking (Signature, std::size_t count, const EntityID*, Tick tick, Tick* const versions[], Components*...)
+         */
+        template<typename Function>
+        void eachChunk(Function&& function) const {
+            for (Archetype* archetype : _data->archetypes)
+                chunksOfArchetype(*archetype, function, *_data->tick, std::index_sequence_for<Components...>{});
+        }
+
+    private:
+        /**
+         * @brief Marks the first rows of a column as changed, unless the component is read only
+         */
+        template<typename Component>
+        static void stamp(Archetype& archetype, std::size_t chunk, std::size_t column, std::size_t count, Tick tick) {
+            if constexpr (!std::is_const_v<Component>)
+                std::fill_n(archetype.versions(chunk, column), count, tick);
+        }
+
+        template<typename Function, std::size_t... I>
+        static void chunksOfArchetype(Archetype& archetype, Function& function, Tick tick, std::index_sequence<I...>) {
+            const std::size_t columns[] = {archetype.columnOf(ComponentRegistry::id<Components>())...};
+
+            for (std::size_t chunk = 0; chunk < archetype.chunkCount(); ++chunk) {
+                Tick* const versions[] = {archetype.versions(chunk, columns[I])...};
+                function(archetype.signature(), archetype.chunkSize(chunk), static_cast<const EntityID*>(archetype.entities(chunk)),
+                    tick, versions, archetype.column<Components>(chunk, columns[I])...);
+            }
+        }
+
+        template<typename Function, std::size_t... I>
+        static void eachInArchetype(Archetype& archetype, Function& function, Tick tick, std::index_sequence<I...>) {
+            const std::size_t columns[] = {archetype.columnOf(ComponentRegistry::id<Components>())...};
+
+            for (std::size_t chunk = 0; chunk < archetype.chunkCount(); ++chunk) {
+                const EntityID* ids = archetype.entities(chunk);
+                std::tuple<Components*...> data{archetype.column<Components>(chunk, columns[I])...};
+                std::size_t count = archetype.chunkSize(chunk);
+
+                (stamp<Components>(archetype, chunk, columns[I], count, tick), ...);
+                for (std::size_t row = 0; row < count; ++row)
+                    function(ids[row], std::get<I>(data)[row]...);
+            }
+        }
+
+        template<typename Function, std::size_t... I>
+        void changedInArchetype(Archetype& archetype, Tick since, Function&& function, std::index_sequence<I...>, bool mutableAccess) const {
+            const std::size_t columns[] = {archetype.columnOf(ComponentRegistry::id<Components>())...};
+            const Tick tick = *_data->tick;
+
+            for (std::size_t chunk = 0; chunk < archetype.chunkCount(); ++chunk) {
+                const EntityID* ids = archetype.entities(chunk);
+                std::tuple<Components*...> data{archetype.column<Components>(chunk, columns[I])...};
+                Tick* const versions[] = {archetype.versions(chunk, columns[I])...};
+                std::size_t count = archetype.chunkSize(chunk);
+
+                for (std::size_t row = 0; row < count; ++row) {
+                    if (!((versions[I][row] > since) || ...))
+                        continue;
+                    if (mutableAccess)
+                        ((std::is_const_v<Components> ? void() : void(versions[I][row] = tick)), ...);
+                    function(ids[row], std::get<I>(data)[row]...);
+                }
+            }
+        }
+
+        ViewData* _data;
+    };
+}
@@ -37,7 +37,7 @@ namespace rtype::network {
             uint8_t version;       ///< Version du protocole
             uint8_t type;         ///< Type de paquet (@see PacketType)
             uint16_t length;      ///< Longueur totale du paquet incluant l'en-tête
-            uint16_t sequence;    ///< Numéro de séquence pour le suivi des paquets
+            uint16_t sequence;    ///< Numéro de séquence pour le suivi des paquets (serveur : 16 bits de poids faible du tick)
         };
 
     /**
@@ -57,6 +57,8 @@ namespace rtype::network {
         ENTITY_DEATH = 0x21, ///< Entity death
         END_GAME_STATE = 0x22, ///< End of the game
         LOOSE_GAME_STATE = 0x23, ///< Game loose
+        ENTITY_DESPAWN = 0x24, ///< Entities removed without dying, several per packet
+        TILE_CHUNK = 0x25, ///< Chunk of the level geometry
         SCORE_UPDATE = 0x30,    ///< score as been update
         BEST_SCORE = 0x31,      ///< Best score of the player as been set
         PLAYER_STATS = 0x32,    ///< Player statistics
@@ -83,6 +85,46 @@ namespace rtype::network {
         int level; ///< current level of the entity
         bool isMainPlayer;   // Add this field to identify the local player
         uint32_t playerNumber; // Add this to distinguish between different players
+        uint32_t generation; ///< Generation of entityId, lets the client drop updates about a destroyed entity
+        uint32_t generation2; ///< Generation of entityId2
+    };
+
+    /**
+     * @brief Most entities in one despawn packet, so it fits the 1024-byte receive buffer of the client
+     */
+    constexpr uint32_t MAX_DESPAWNS_PER_PACKET = 120;
+
+    /**
+     * @brief Seconds between two HEARTBEAT packets of a client, well under the timeout of the server
+     */
+    constexpr float HEARTBEAT_INTERVAL = 1.0f;
+
+    /**
+     * @brief entity despawn packet
+     *
+     * Followed by count DespawnEntry, the entities that expired or left the screen during a tick.
+     */
+    struct EntityDespawnPacket {
+        uint32_t count; ///< Number of entries following the packet
+    };
+
+    /**
+     * @brief One entity of an entity despawn packet
+     */
+    struct DespawnEntry {
+        uint32_t entityId; ///< ID of the entity
+        uint32_t generation; ///< Generation of entityId
+    };
+
+    /**
+     * @brief tile chunk packet
+     *
+     * Sent once when a chunk of the level geometry comes into view, and again on keyframes.
+     */
+    struct TileChunkPacket {
+        uint32_t index; ///< Position of the chunk in the scrolled level
+        double scroll; ///< Distance scrolled by the level when the packet was sent
+        uint32_t columns[16]; ///< Solid tiles of each column (physics::CHUNK_COLUMNS), bit N for row N
     };
 
     /**
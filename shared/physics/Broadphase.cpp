@@ -0,0 +1,118 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** Broadphase
+*/
+#include "Broadphase.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace rtype::physics {
+    UniformGrid::UniformGrid(float cellSize, float width, float height)
+        : _inverseCell(1.0f / cellSize),
+          _columns(std::max(1, static_cast<int>(std::ceil(width / cellSize)))),
+          _rows(std::max(1, static_cast<int>(std::ceil(height / cellSize)))) {
+        _starts.assign(static_cast<std::size_t>(_columns) * _rows * MAX_LAYERS + 1, 0);
+    }
+
+    void UniformGrid::clear() {
+        _items.clear();
+        _sorted.clear();
+        std::fill(_starts.begin(), _starts.end(), 0);
+    }
+
+    void UniformGrid::insert(EntityID entity, std::uint32_t layer, const Aabb& box) {
+        if (std::popcount(layer) != 1 || layerIndex(layer) >= MAX_LAYERS)
+            throw std::invalid_argument("A collider must be on exactly one collision layer");
+        _items.push_back(Item{entity, layer, box, cellsOf(box)});
+    }
+
+    void UniformGrid::build() {
+        // Counting sort by (cell, layer): count, turn the counts into slot ends, then fill every
+        // slot from its end, visiting the items backwards so each slot keeps the insertion order
+        std::fill(_starts.begin(), _starts.end(), 0);
+        std::size_t total = 0;
+        for (const Item& item : _items) {
+            const std::size_t layer = layerIndex(item.layer);
+            for (int cy = item.cells.minY; cy <= item.cells.maxY; ++cy) {
+                for (int cx = item.cells.minX; cx <= item.cells.maxX; ++cx)
+                    _starts[(static_cast<std::size_t>(cy) * _columns + cx) * MAX_LAYERS + layer]++;
+            }
+            total += static_cast<std::size_t>(item.cells.maxX - item.cells.minX + 1) * (item.cells.maxY - item.cells.minY + 1);
+        }
+        std::uint32_t end = 0;
+        for (std::size_t slot = 0; slot + 1 < _starts.size(); ++slot) {
+            end += _starts[slot];
+            _starts[slot] = end;
+        }
+        _starts.back() = end;
+        _sorted.resize(total);
+        for (std::size_t i = _items.size(); i-- > 0;) {
+            const Item& item = _items[i];
+            const std::size_t layer = layerIndex(item.layer);
+            for (int cy = item.cells.minY; cy <= item.cells.maxY; ++cy) {
+                for (int cx = item.cells.minX; cx <= item.cells.maxX; ++cx)
+                    _sorted[--_starts[(static_cast<std::size_t>(cy) * _columns + cx) * MAX_LAYERS + layer]] = static_cast<std::uint32_t>(i);
+            }
+        }
+    }
+
+    void UniformGrid::collectPairs(const CollisionMatrix& matrix, std::vector<CollisionPair>& pairs) const {
+        pairs.clear();
+        const std::size_t cells = static_cast<std::size_t>(_columns) * _rows;
+
+        for (std::size_t cell = 0; cell < cells; ++cell) {
+            const int cx = static_cast<int>(cell % _columns);
+            const int cy = static_cast<int>(cell / _columns);
+            const std::size_t base = cell * MAX_LAYERS;
+
+            for (std::size_t la = 0; la < MAX_LAYERS; ++la) {
+                if (_starts[base + la] == _starts[base + la + 1])
+                    continue;
+                // Each pair of layers is visited once, from its lowest layer
+                const std::uint32_t others = matrix.mask(std::uint32_t{1} << la) & ~((std::uint32_t{1} << la) - 1);
+                for (std::uint32_t bits = others; bits != 0; bits &= bits - 1) {
+                    const std::size_t lb = std::countr_zero(bits);
+                    for (std::uint32_t i = _starts[base + la]; i < _starts[base + la + 1]; ++i) {
+                        const Item& a = _items[_sorted[i]];
+                        for (std::uint32_t j = (la == lb ? i + 1 : _starts[base + lb]); j < _starts[base + lb + 1]; ++j) {
+                            const Item& b = _items[_sorted[j]];
+                            // Reported from the first cell both boxes share only
+                            if (cx != std::max(a.cells.minX, b.cells.minX) || cy != std::max(a.cells.minY, b.cells.minY))
+                                continue;
+                            if (!a.box.overlaps(b.box))
+                                continue;
+                            if (la == lb && b.entity < a.entity)
+                                pairs.push_back(CollisionPair{b.entity, a.entity, b.layer, a.layer});
+                            else
+                                pairs.push_back(CollisionPair{a.entity, b.entity, a.layer, b.layer});
+                        }
+                    }
+                }
+            }
+        }
+        std::sort(pairs.begin(), pairs.end(), [](const CollisionPair& lhs, const CollisionPair& rhs) {
+            if (lhs.first != rhs.first)
+                return lhs.first < rhs.first;
+            if (lhs.secondLayer != rhs.secondLayer)
+                return lhs.secondLayer < rhs.secondLayer;
+            return lhs.second < rhs.second;
+        });
+    }
+
+    UniformGrid::CellRange UniformGrid::cellsOf(const Aabb& box) const {
+        return {column(box.minX), row(box.minY), column(box.maxX), row(box.maxY)};
+    }
+
+    int UniformGrid::column(float x) const {
+        // NaN positions land in the first cell
+        const float cell = std::floor(x * _inverseCell);
+        return cell >= 0.0f ? std::min(static_cast<int>(std::min(cell, 1e6f)), _columns - 1) : 0;
+    }
+
+    int UniformGrid::row(float y) const {
+        const float cell = std::floor(y * _inverseCell);
+        return cell >= 0.0f ? std::min(static_cast<int>(std::min(cell, 1e6f)), _rows - 1) : 0;
+    }
+}
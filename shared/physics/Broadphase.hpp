@@ -0,0 +1,219 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** Broadphase
+*/
+#pragma once
+#include "../ecs/Component.hpp"
+#include "../ecs/Entity.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Collision broadphase: finds the pairs of entities close enough to be worth an exact test
+ *
+ * @details Entities are binned by bounding box in a UniformGrid rebuilt every tick, and only the
+ * layers enabled in a CollisionMatrix are paired. The exact shape tests (see Narrowphase.hpp) are
+ * left to the caller, which usually has more gameplay checks to run on the pair anyway.
+ */
+namespace rtype::physics {
+    constexpr std::size_t MAX_LAYERS = 8; ///< Layers are the low bits of Collider::layer
+    constexpr float CELL_SIZE = 64.0f; ///< About three enemies wide
+    constexpr float WORLD_WIDTH = 800.0f;
+    constexpr float WORLD_HEIGHT = 600.0f;
+
+    /**
+     * @struct Aabb
+     * @brief Axis-aligned bounding box
+     */
+    struct Aabb {
+        float minX;
+        float minY;
+        float maxX;
+        float maxY;
+
+        bool overlaps(const Aabb& other) const {
+            return minX <= other.maxX && other.minX <= maxX && minY <= other.maxY && other.minY <= maxY;
+        }
+    };
+
+    /**
+     * @brief Gets the bounding box of a collider
+     * @param pos The position of the entity
+     * @param collider The collider of the entity
+     */
+    inline Aabb boundsOf(const Position& pos, const Collider& collider) {
+        if (collider.width > 0.0f || collider.height > 0.0f)
+            return {pos.x, pos.y, pos.x + collider.width, pos.y + collider.height};
+        return {pos.x - collider.radius, pos.y - collider.radius, pos.x + collider.radius, pos.y + collider.radius};
+    }
+
+    /**
+     * @brief Gets the index of a one-bit layer
+     */
+    inline std::size_t layerIndex(std::uint32_t layer) {
+        return static_cast<std::size_t>(std::countr_zero(layer));
+    }
+
+    /**
+     * @class CollisionMatrix
+     * @brief Symmetric table of the layers that collide with each other
+     */
+    class CollisionMatrix {
+    public:
+        /**
+         * @brief Makes two layers collide
+         * @param a One CollisionLayer bit
+         * @param b One CollisionLayer bit, may be a
+         */
+        void enable(std::uint32_t a, std::uint32_t b) {
+            _masks[layerIndex(a)] |= b;
+            _masks[layerIndex(b)] |= a;
+        }
+
+        /**
+         * @brief Gets the layers colliding with a layer
+         */
+        std::uint32_t mask(std::uint32_t layer) const { return _masks[layerIndex(layer)]; }
+
+        bool interacts(std::uint32_t a, std::uint32_t b) const { return (mask(a) & b) != 0; }
+
+        /**
+         * @brief Gets the R-Type rules: shots hit the other side, pickups are taken by players,
+         * everything stops on walls
+         */
+        static CollisionMatrix standard() {
+            CollisionMatrix matrix;
+            matrix.enable(LAYER_PLAYER_SHOT, LAYER_ENEMY);
+            matrix.enable(LAYER_ENEMY_SHOT, LAYER_PLAYER);
+            matrix.enable(LAYER_PLAYER, LAYER_PICKUP);
+            for (std::uint32_t layer : {LAYER_PLAYER_SHOT, LAYER_ENEMY_SHOT, LAYER_PLAYER, LAYER_ENEMY})
+                matrix.enable(layer, LAYER_WALL);
+            return matrix;
+        }
+
+    private:
+        std::array<std::uint32_t, MAX_LAYERS> _masks{};
+    };
+
+    /**
+     * @struct CollisionPair
+     * @brief Two entities whose bounding boxes overlap, the one on the lowest layer first
+     */
+    struct CollisionPair {
+        EntityID first;
+        EntityID second;
+        std::uint32_t firstLayer;
+        std::uint32_t secondLayer;
+    };
+
+    /**
+     * @class UniformGrid
+     * @brief Grid of square cells over the play area, each listing the boxes overlapping it
+     *
+     * @details Usage per tick: clear, insert every collider, build, then query or collectPairs.
+     * Boxes outside the play area are clamped into the border cells, so they are still found,
+     * only less efficiently. build sorts the boxes by cell and layer into flat arrays: once the
+     * arrays have grown to the largest tick, rebuilding the grid does not allocate.
+     * A box overlapping several cells is listed in each of them and reported once.
+     */
+    class UniformGrid {
+    public:
+        /**
+         * @brief Constructs a grid covering the play area
+         * @param cellSize The side of a cell, about the size of the largest common collider
+         * @param width The width of the play area
+         * @param height The height of the play area
+         */
+        explicit UniformGrid(float cellSize = CELL_SIZE, float width = WORLD_WIDTH, float height = WORLD_HEIGHT);
+
+        /**
+         * @brief Removes every box, keeping the memory
+         */
+        void clear();
+
+        /**
+         * @brief Adds a box, visible once build is called
+         * @param entity The entity owning the box
+         * @param layer One CollisionLayer bit
+         * @param box The bounding box
+         */
+        void insert(EntityID entity, std::uint32_t layer, const Aabb& box);
+
+        /**
+         * @brief Sorts the inserted boxes into the cells
+         */
+        void build();
+
+        /**
+         * @brief Gets the number of inserted boxes
+         */
+        std::size_t size() const { return _items.size(); }
+
+        /**
+         * @brief Calls a function once for every box of the given layers overlapping a box
+         * @details Boxes are visited cell by cell, not in a meaningful order.
+         * @param box The box to search
+         * @param layers The CollisionLayer bits to search
+         * @param function Callable taking the EntityID and the layer of each box found
+         */
+        template<typename Function>
+        void query(const Aabb& box, std::uint32_t layers, Function&& function) const {
+            const CellRange range = cellsOf(box);
+            for (int cy = range.minY; cy <= range.maxY; ++cy) {
+                for (int cx = range.minX; cx <= range.maxX; ++cx) {
+                    const std::size_t cell = static_cast<std::size_t>(cy) * _columns + cx;
+                    for (std::uint32_t bits = layers; bits != 0; bits &= bits - 1) {
+                        const std::size_t slot = cell * MAX_LAYERS + std::countr_zero(bits);
+                        for (std::uint32_t i = _starts[slot]; i < _starts[slot + 1]; ++i) {
+                            const Item& item = _items[_sorted[i]];
+                            // Reported from the first cell both boxes share only
+                            if (cx != std::max(range.minX, item.cells.minX) || cy != std::max(range.minY, item.cells.minY))
+                                continue;
+                            if (item.box.overlaps(box))
+                                function(item.entity, item.layer);
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Lists every pair of overlapping boxes whose layers collide
+         * @param matrix The layers colliding with each other
+         * @param pairs Filled with the pairs, cleared first, sorted by first entity, second layer then second entity
+         */
+        void collectPairs(const CollisionMatrix& matrix, std::vector<CollisionPair>& pairs) const;
+
+    private:
+        struct CellRange {
+            int minX;
+            int minY;
+            int maxX;
+            int maxY;
+        };
+
+        struct Item {
+            EntityID entity;
+            std::uint32_t layer;
+            Aabb box;
+            CellRange cells;
+        };
+
+        CellRange cellsOf(const Aabb& box) const;
+        int column(float x) const;
+        int row(float y) const;
+
+        float _inverseCell;
+        int _columns;
+        int _rows;
+        std::vector<Item> _items; ///< Boxes in insertion order
+        std::vector<std::uint32_t> _starts; ///< First index in _sorted of every (cell, layer) slot, plus the end
+        std::vector<std::uint32_t> _sorted; ///< Item indices sorted by cell then layer, one per overlapped cell
+    };
+}
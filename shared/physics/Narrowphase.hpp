@@ -0,0 +1,332 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** Narrowphase
+*/
+#pragma once
+#include "../ecs/Component.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+    #include <immintrin.h>
+    #define RTYPE_NARROWPHASE_SSE
+#endif
+
+/**
+ * @brief Exact collision tests, one pair at a time or one circle against many shapes
+ *
+ * @details The swept tests check the whole straight motion of a circle over a step, so fast
+ * shots cannot tunnel through thin targets between two ticks.
+ *
+ * Batch kernels read shapes packed as separate arrays (CircleSet, RectSet) and test
+ * four or eight of them per instruction: SSE2 on every x86-64 build, AVX when the compiler
+ * targets it (RTYPE_ENABLE_AVX2), the scalar loop elsewhere. Every path computes the same
+ * results as circleHitsCircle and circleHitsRect. Results are hit masks: bit N of word W is
+ * set when shape W * 64 + N is hit.
+ */
+namespace rtype::physics {
+    /**
+     * @brief Checks if two circles overlap
+     * @param a The center of the first circle
+     * @param radiusA The radius of the first circle
+     * @param b The center of the second circle
+     * @param radiusB The radius of the second circle
+     */
+    inline bool circleHitsCircle(const Position& a, float radiusA, const Position& b, float radiusB) {
+        const float dx = a.x - b.x;
+        const float dy = a.y - b.y;
+        const float radiusSum = radiusA + radiusB;
+        return (dx * dx + dy * dy) <= (radiusSum * radiusSum);
+    }
+
+    /**
+     * @brief Checks if a circle and a rectangle overlap
+     * @param center The center of the circle
+     * @param radius The radius of the circle
+     * @param rect The top-left corner of the rectangle
+     * @param width The width of the rectangle
+     * @param height The height of the rectangle
+     */
+    inline bool circleHitsRect(const Position& center, float radius, const Position& rect, float width, float height) {
+        const float closestX = std::max(rect.x, std::min(center.x, rect.x + width));
+        const float closestY = std::max(rect.y, std::min(center.y, rect.y + height));
+        const float dx = center.x - closestX;
+        const float dy = center.y - closestY;
+        return (dx * dx + dy * dy) <= (radius * radius);
+    }
+
+    /**
+     * @brief Checks if two colliders overlap: circle/circle, circle/rectangle or rectangle/rectangle
+     */
+    inline bool intersects(const Position& posA, const Collider& a, const Position& posB, const Collider& b) {
+        const bool rectA = a.width > 0.0f || a.height > 0.0f;
+        const bool rectB = b.width > 0.0f || b.height > 0.0f;
+
+        if (rectA && rectB)
+            return posA.x <= posB.x + b.width && posB.x <= posA.x + a.width && posA.y <= posB.y + b.height && posB.y <= posA.y + a.height;
+        if (rectA)
+            return circleHitsRect(posB, b.radius, posA, a.width, a.height);
+        if (rectB)
+            return circleHitsRect(posA, a.radius, posB, b.width, b.height);
+        return circleHitsCircle(posA, a.radius, posB, b.radius);
+    }
+
+    /**
+     * @brief Checks if a segment crosses an axis-aligned box
+     * @param start The start of the segment
+     * @param motion The vector from the start to the end of the segment
+     */
+    inline bool segmentHitsBox(const Position& start, const Velocity& motion, float minX, float minY, float maxX, float maxY) {
+        // Slab test: intersect the parameter ranges where the segment is inside each axis band
+        float enter = 0.0f;
+        float exit = 1.0f;
+        const float origins[] = {start.x, start.y};
+        const float deltas[] = {motion.dx, motion.dy};
+        const float mins[] = {minX, minY};
+        const float maxs[] = {maxX, maxY};
+
+        for (int axis = 0; axis < 2; ++axis) {
+            if (deltas[axis] == 0.0f) {
+                if (origins[axis] < mins[axis] || origins[axis] > maxs[axis])
+                    return false;
+                continue;
+            }
+            float low = (mins[axis] - origins[axis]) / deltas[axis];
+            float high = (maxs[axis] - origins[axis]) / deltas[axis];
+            if (low > high)
+                std::swap(low, high);
+            enter = std::max(enter, low);
+            exit = std::min(exit, high);
+            if (enter > exit)
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Checks if a circle moving in a straight line touches a circle at some point of its motion
+     * @param start The center of the moving circle at the start of the step
+     * @param motion The displacement of the moving circle over the step (velocity * dt)
+     * @param radius The radius of the moving circle
+     * @param center The center of the other circle
+     * @param otherRadius The radius of the other circle
+     */
+    inline bool sweptCircleHitsCircle(const Position& start, const Velocity& motion, float radius, const Position& center, float otherRadius) {
+        // Closest point of the path to the center
+        const float lengthSquared = motion.dx * motion.dx + motion.dy * motion.dy;
+        float t = 0.0f;
+        if (lengthSquared > 0.0f)
+            t = std::clamp(((center.x - start.x) * motion.dx + (center.y - start.y) * motion.dy) / lengthSquared, 0.0f, 1.0f);
+        return circleHitsCircle({start.x + motion.dx * t, start.y + motion.dy * t}, radius, center, otherRadius);
+    }
+
+    /**
+     * @brief Checks if a circle moving in a straight line touches a rectangle at some point of its motion
+     * @param start The center of the moving circle at the start of the step
+     * @param motion The displacement of the moving circle over the step (velocity * dt)
+     * @param radius The radius of the moving circle
+     * @param rect The top-left corner of the rectangle
+     * @param width The width of the rectangle
+     * @param height The height of the rectangle
+     */
+    inline bool sweptCircleHitsRect(const Position& start, const Velocity& motion, float radius, const Position& rect, float width, float height) {
+        // The center path must cross the rectangle grown by the radius, with rounded corners:
+        // the union of the rectangle grown along each axis and of the four corner circles
+        if (segmentHitsBox(start, motion, rect.x - radius, rect.y, rect.x + width + radius, rect.y + height)
+            || segmentHitsBox(start, motion, rect.x, rect.y - radius, rect.x + width, rect.y + height + radius))
+            return true;
+        for (const Position corner : {rect, Position{rect.x + width, rect.y}, Position{rect.x, rect.y + height}, Position{rect.x + width, rect.y + height}}) {
+            if (sweptCircleHitsCircle(start, motion, radius, corner, 0.0f))
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Checks if a moving collider touches a static one at some point of its motion
+     * @details The moving collider must be a circle, use the relative motion when both move.
+     * @param start The position of the moving collider at the start of the step
+     * @param motion The displacement of the moving collider over the step
+     * @param a The moving collider
+     * @param posB The position of the static collider
+     * @param b The static collider
+     */
+    inline bool sweptIntersects(const Position& start, const Velocity& motion, const Collider& a, const Position& posB, const Collider& b) {
+        if (b.width > 0.0f || b.height > 0.0f)
+            return sweptCircleHitsRect(start, motion, a.radius, posB, b.width, b.height);
+        return sweptCircleHitsCircle(start, motion, a.radius, posB, b.radius);
+    }
+
+    /**
+     * @brief Gets the number of mask words needed for a number of shapes
+     */
+    constexpr std::size_t maskWords(std::size_t count) {
+        return (count + 63) / 64;
+    }
+
+    /**
+     * @struct CircleSet
+     * @brief Circles packed as one array per field
+     */
+    struct CircleSet {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> radius;
+
+        void clear() {
+            x.clear();
+            y.clear();
+            radius.clear();
+        }
+
+        void push(const Position& center, float circleRadius) {
+            x.push_back(center.x);
+            y.push_back(center.y);
+            radius.push_back(circleRadius);
+        }
+
+        std::size_t size() const { return x.size(); }
+    };
+
+    /**
+     * @struct RectSet
+     * @brief Rectangles packed as one array per field, positioned by their top-left corner
+     */
+    struct RectSet {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> width;
+        std::vector<float> height;
+
+        void clear() {
+            x.clear();
+            y.clear();
+            width.clear();
+            height.clear();
+        }
+
+        void push(const Position& corner, float rectWidth, float rectHeight) {
+            x.push_back(corner.x);
+            y.push_back(corner.y);
+            width.push_back(rectWidth);
+            height.push_back(rectHeight);
+        }
+
+        std::size_t size() const { return x.size(); }
+    };
+
+    /**
+     * @brief Tests one circle against many circles
+     * @param center The center of the circle
+     * @param radius The radius of the circle
+     * @param circles The circles to test
+     * @param hits Receives maskWords(circles.size()) words, bit i set if circle i is hit
+     */
+    inline void circleHitsCircles(const Position& center, float radius, const CircleSet& circles, std::uint64_t* hits) {
+        const std::size_t count = circles.size();
+        const float* xs = circles.x.data();
+        const float* ys = circles.y.data();
+        const float* radii = circles.radius.data();
+        std::fill_n(hits, maskWords(count), 0);
+        std::size_t i = 0;
+
+        // Groups of 4 or 8 start on a multiple of their size, so they never straddle two words
+#if defined(__AVX__)
+        const __m256 cx8 = _mm256_set1_ps(center.x);
+        const __m256 cy8 = _mm256_set1_ps(center.y);
+        const __m256 r8 = _mm256_set1_ps(radius);
+        for (; i + 8 <= count; i += 8) {
+            const __m256 dx = _mm256_sub_ps(cx8, _mm256_loadu_ps(xs + i));
+            const __m256 dy = _mm256_sub_ps(cy8, _mm256_loadu_ps(ys + i));
+            const __m256 sum = _mm256_add_ps(r8, _mm256_loadu_ps(radii + i));
+            const __m256 distance = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+            const int mask = _mm256_movemask_ps(_mm256_cmp_ps(distance, _mm256_mul_ps(sum, sum), _CMP_LE_OQ));
+            hits[i / 64] |= static_cast<std::uint64_t>(mask) << (i % 64);
+        }
+#endif
+#if defined(RTYPE_NARROWPHASE_SSE)
+        const __m128 cx4 = _mm_set1_ps(center.x);
+        const __m128 cy4 = _mm_set1_ps(center.y);
+        const __m128 r4 = _mm_set1_ps(radius);
+        for (; i + 4 <= count; i += 4) {
+            const __m128 dx = _mm_sub_ps(cx4, _mm_loadu_ps(xs + i));
+            const __m128 dy = _mm_sub_ps(cy4, _mm_loadu_ps(ys + i));
+            const __m128 sum = _mm_add_ps(r4, _mm_loadu_ps(radii + i));
+            const __m128 distance = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+            const int mask = _mm_movemask_ps(_mm_cmple_ps(distance, _mm_mul_ps(sum, sum)));
+            hits[i / 64] |= static_cast<std::uint64_t>(mask) << (i % 64);
+        }
+#endif
+        for (; i < count; ++i) {
+            if (circleHitsCircle(center, radius, {xs[i], ys[i]}, radii[i]))
+                hits[i / 64] |= std::uint64_t{1} << (i % 64);
+        }
+    }
+
+    /**
+     * @brief Tests one circle against many rectangles
+     * @param center The center of the circle
+     * @param radius The radius of the circle
+     * @param rects The rectangles to test
+     * @param hits Receives maskWords(rects.size()) words, bit i set if rectangle i is hit
+     */
+    inline void circleHitsRects(const Position& center, float radius, const RectSet& rects, std::uint64_t* hits) {
+        const std::size_t count = rects.size();
+        const float* xs = rects.x.data();
+        const float* ys = rects.y.data();
+        const float* widths = rects.width.data();
+        const float* heights = rects.height.data();
+        std::fill_n(hits, maskWords(count), 0);
+        std::size_t i = 0;
+
+#if defined(__AVX__)
+        const __m256 cx8 = _mm256_set1_ps(center.x);
+        const __m256 cy8 = _mm256_set1_ps(center.y);
+        const __m256 r8 = _mm256_set1_ps(radius);
+        for (; i + 8 <= count; i += 8) {
+            const __m256 left = _mm256_loadu_ps(xs + i);
+            const __m256 top = _mm256_loadu_ps(ys + i);
+            const __m256 closestX = _mm256_max_ps(left, _mm256_min_ps(cx8, _mm256_add_ps(left, _mm256_loadu_ps(widths + i))));
+            const __m256 closestY = _mm256_max_ps(top, _mm256_min_ps(cy8, _mm256_add_ps(top, _mm256_loadu_ps(heights + i))));
+            const __m256 dx = _mm256_sub_ps(cx8, closestX);
+            const __m256 dy = _mm256_sub_ps(cy8, closestY);
+            const __m256 distance = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+            const int mask = _mm256_movemask_ps(_mm256_cmp_ps(distance, _mm256_mul_ps(r8, r8), _CMP_LE_OQ));
+            hits[i / 64] |= static_cast<std::uint64_t>(mask) << (i % 64);
+        }
+#endif
+#if defined(RTYPE_NARROWPHASE_SSE)
+        const __m128 cx4 = _mm_set1_ps(center.x);
+        const __m128 cy4 = _mm_set1_ps(center.y);
+        const __m128 r4 = _mm_set1_ps(radius);
+        for (; i + 4 <= count; i += 4) {
+            const __m128 left = _mm_loadu_ps(xs + i);
+            const __m128 top = _mm_loadu_ps(ys + i);
+            const __m128 closestX = _mm_max_ps(left, _mm_min_ps(cx4, _mm_add_ps(left, _mm_loadu_ps(widths + i))));
+            const __m128 closestY = _mm_max_ps(top, _mm_min_ps(cy4, _mm_add_ps(top, _mm_loadu_ps(heights + i))));
+            const __m128 dx = _mm_sub_ps(cx4, closestX);
+            const __m128 dy = _mm_sub_ps(cy4, closestY);
+            const __m128 distance = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+            const int mask = _mm_movemask_ps(_mm_cmple_ps(distance, _mm_mul_ps(r4, r4)));
+            hits[i / 64] |= static_cast<std::uint64_t>(mask) << (i % 64);
+        }
+#endif
+        for (; i < count; ++i) {
+            if (circleHitsRect(center, radius, {xs[i], ys[i]}, widths[i], heights[i]))
+                hits[i / 64] |= std::uint64_t{1} << (i % 64);
+        }
+    }
+
+    /**
+     * @brief Checks if any bit of a hit mask is set
+     */
+    inline bool anyHit(const std::uint64_t* hits, std::size_t count) {
+        return std::any_of(hits, hits + maskWords(count), [](std::uint64_t word) { return word != 0; });
+    }
+}
@@ -0,0 +1,109 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** TileMap
+*/
+#include "TileMap.hpp"
+#include <sstream>
+#include <stdexcept>
+
+namespace rtype::physics {
+    TileLevel TileLevel::parse(std::istream& input) {
+        std::vector<std::string> rows;
+        for (std::string line; std::getline(input, line);) {
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+            if (line.empty())
+                continue;
+            if (!rows.empty() && line.size() != rows.front().size())
+                throw std::runtime_error("Level rows must all have the same length");
+            rows.push_back(line);
+        }
+        if (rows.size() != static_cast<std::size_t>(TILE_ROWS))
+            throw std::runtime_error("A level must have " + std::to_string(TILE_ROWS) + " rows");
+
+        TileLevel level;
+        const std::size_t width = rows.front().size();
+        level._columns.assign((width + CHUNK_COLUMNS - 1) / CHUNK_COLUMNS * CHUNK_COLUMNS, 0);
+        for (std::size_t row = 0; row < rows.size(); ++row) {
+            for (std::size_t column = 0; column < width; ++column) {
+                const char tile = rows[row][column];
+                if (tile == '#')
+                    level._columns[column] |= TileColumn{1} << row;
+                else if (tile != '.')
+                    throw std::runtime_error(std::string("Unknown level tile '") + tile + "'");
+            }
+        }
+        return level;
+    }
+
+    TileLevel TileLevel::parse(const std::string& text) {
+        std::istringstream input(text);
+        return parse(input);
+    }
+
+    TileChunk TileLevel::chunk(std::uint32_t index) const {
+        TileChunk chunk;
+        chunk.index = index;
+        if (chunkCount() == 0)
+            return chunk;
+        const std::size_t first = (index % chunkCount()) * CHUNK_COLUMNS;
+        std::copy_n(_columns.begin() + static_cast<std::ptrdiff_t>(first), CHUNK_COLUMNS, chunk.columns.begin());
+        return chunk;
+    }
+
+    void TileMap::load(const TileChunk& chunk) {
+        const std::size_t slot = chunk.index % LOADED_CHUNKS;
+        _chunks[slot] = chunk;
+        _loaded[slot] = true;
+    }
+
+    void TileMap::unloadBefore(std::uint32_t index) {
+        for (std::size_t slot = 0; slot < LOADED_CHUNKS; ++slot) {
+            if (_loaded[slot] && _chunks[slot].index < index)
+                _loaded[slot] = false;
+        }
+    }
+
+    void TileMap::clear() {
+        _loaded.fill(false);
+        _scroll = 0.0;
+    }
+
+    bool TileMap::isLoaded(std::uint32_t index) const {
+        const std::size_t slot = index % LOADED_CHUNKS;
+        return _loaded[slot] && _chunks[slot].index == index;
+    }
+
+    std::uint32_t TileMap::firstVisibleChunk() const {
+        return static_cast<std::uint32_t>(std::max(0.0, std::floor((_scroll - STREAM_MARGIN) / CHUNK_WIDTH)));
+    }
+
+    std::uint32_t TileMap::lastVisibleChunk() const {
+        return static_cast<std::uint32_t>(std::max(0.0, std::floor((_scroll + WORLD_WIDTH + STREAM_MARGIN) / CHUNK_WIDTH)));
+    }
+
+    bool TileMap::circleHits(const Position& center, float radius) const {
+        return anyRun({center.x - radius, center.y - radius, center.x + radius, center.y + radius},
+            [&](const Position& corner, float width, float height) {
+                return circleHitsRect(center, radius, corner, width, height);
+            });
+    }
+
+    bool TileMap::sweptCircleHits(const Position& start, const Velocity& motion, float radius) const {
+        const Aabb box{std::min(start.x, start.x + motion.dx) - radius, std::min(start.y, start.y + motion.dy) - radius,
+            std::max(start.x, start.x + motion.dx) + radius, std::max(start.y, start.y + motion.dy) + radius};
+        return anyRun(box, [&](const Position& corner, float width, float height) {
+            return sweptCircleHitsRect(start, motion, radius, corner, width, height);
+        });
+    }
+
+    TileColumn TileMap::columnAt(std::int64_t column) const {
+        const auto index = static_cast<std::uint32_t>(column / CHUNK_COLUMNS);
+        const std::size_t slot = index % LOADED_CHUNKS;
+        if (!_loaded[slot] || _chunks[slot].index != index)
+            return 0;
+        return _chunks[slot].columns[static_cast<std::size_t>(column % CHUNK_COLUMNS)];
+    }
+}
@@ -0,0 +1,193 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** TileMap
+*/
+#pragma once
+#include "Broadphase.hpp"
+#include "Narrowphase.hpp"
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Static level geometry: a scrolling grid of solid tiles, streamed in chunks
+ *
+ * @details A level is a grid TILE_ROWS tiles high, as wide as needed, cut into chunks of
+ * CHUNK_COLUMNS columns. It scrolls to the left at LEVEL_SCROLL_SPEED and loops once its last
+ * chunk is reached, so chunk indices keep growing while their content repeats. Each column is a
+ * bitmask of its solid rows: collision queries only visit the columns under the queried box, and
+ * a chunk fits in a small packet.
+ */
+namespace rtype::physics {
+    constexpr float TILE_SIZE = 20.0f; ///< Side of a tile, in pixels
+    constexpr int TILE_ROWS = 30; ///< Rows of a level, the height of the screen
+    constexpr int CHUNK_COLUMNS = 16; ///< Columns of a chunk
+    constexpr float CHUNK_WIDTH = TILE_SIZE * CHUNK_COLUMNS;
+    constexpr float LEVEL_SCROLL_SPEED = 40.0f; ///< Pixels per second, the speed of the front star layer
+    constexpr float STREAM_MARGIN = 64.0f; ///< Chunks are loaded this far past the edges of the screen
+    constexpr std::size_t LOADED_CHUNKS = 8; ///< Chunks held at once, more than the screen and margins span
+
+    using TileColumn = std::uint32_t; ///< Solid tiles of a column, bit N for row N
+
+    /**
+     * @brief Columns of one chunk of a level
+     */
+    struct TileChunk {
+        std::uint32_t index = 0; ///< Position of the chunk in the scrolled level, counting from 0
+        std::array<TileColumn, CHUNK_COLUMNS> columns{};
+    };
+
+    /**
+     * @class TileLevel
+     * @brief Content of a level, the chunks a TileMap loads as it scrolls
+     *
+     * @details The text format has TILE_ROWS lines of the same length, one character per tile:
+     * '#' for a solid tile, '.' for an empty one. Blank lines are skipped. The width is padded with
+     * empty columns up to a whole number of chunks.
+     */
+    class TileLevel {
+    public:
+        /**
+         * @brief Parses a level from its text format
+         * @throw std::runtime_error if the text is not a valid level
+         */
+        static TileLevel parse(std::istream& input);
+
+        /**
+         * @brief Parses a level from its text format
+         * @throw std::runtime_error if the text is not a valid level
+         */
+        static TileLevel parse(const std::string& text);
+
+        /**
+         * @brief Gets the number of chunks before the level loops
+         */
+        std::size_t chunkCount() const { return _columns.size() / CHUNK_COLUMNS; }
+
+        /**
+         * @brief Gets the content of a chunk, the level looping past its last chunk
+         * @param index The index of the chunk in the scrolled level
+         */
+        TileChunk chunk(std::uint32_t index) const;
+
+    private:
+        std::vector<TileColumn> _columns;
+    };
+
+    /**
+     * @class TileMap
+     * @brief Loaded chunks of the scrolling level and the collision queries against them
+     *
+     * @details Chunks are loaded as they come close to the screen and unloaded once they left it,
+     * in any order: each one goes into the slot of its index modulo LOADED_CHUNKS. Queries take
+     * screen coordinates; columns of chunks not loaded are empty.
+     */
+    class TileMap {
+    public:
+        /**
+         * @brief Stores a chunk, replacing the one of its slot
+         */
+        void load(const TileChunk& chunk);
+
+        /**
+         * @brief Unloads the chunks of lower index
+         */
+        void unloadBefore(std::uint32_t index);
+
+        /**
+         * @brief Unloads every chunk and goes back to the start of the level
+         */
+        void clear();
+
+        bool isLoaded(std::uint32_t index) const;
+
+        /**
+         * @brief Gets the first chunk that touches the screen or its margins
+         */
+        std::uint32_t firstVisibleChunk() const;
+
+        /**
+         * @brief Gets the last chunk that touches the screen or its margins
+         */
+        std::uint32_t lastVisibleChunk() const;
+
+        /**
+         * @brief Gets the loaded chunks, unordered
+         * @param function Callable taking a const TileChunk&
+         */
+        template<typename Function>
+        void forEachChunk(Function&& function) const {
+            for (std::size_t slot = 0; slot < LOADED_CHUNKS; ++slot) {
+                if (_loaded[slot])
+                    function(_chunks[slot]);
+            }
+        }
+
+        /**
+         * @brief Gets the distance scrolled since the start of the level, in pixels
+         */
+        double scroll() const { return _scroll; }
+
+        void setScroll(double scroll) { _scroll = scroll; }
+
+        void scrollBy(double distance) { _scroll += distance; }
+
+        /**
+         * @brief Checks the vertical runs of solid tiles touching a box until one passes a test
+         * @param box The box, in screen coordinates
+         * @param test Callable taking the top-left corner, width and height of a run, returning a bool
+         * @return bool True as soon as the test passes for a run
+         */
+        template<typename Function>
+        bool anyRun(const Aabb& box, Function&& test) const {
+            if (box.maxY < 0.0f || box.minY >= TILE_SIZE * TILE_ROWS)
+                return false;
+            const std::int64_t first = std::max<std::int64_t>(0, static_cast<std::int64_t>(std::floor((box.minX + _scroll) / TILE_SIZE)));
+            const std::int64_t last = static_cast<std::int64_t>(std::floor((box.maxX + _scroll) / TILE_SIZE));
+            const int firstRow = std::max(0, static_cast<int>(box.minY / TILE_SIZE));
+            const int lastRow = std::min(TILE_ROWS - 1, static_cast<int>(box.maxY / TILE_SIZE));
+            const TileColumn rows = static_cast<TileColumn>((std::uint64_t{2} << lastRow) - (std::uint64_t{1} << firstRow));
+
+            for (std::int64_t column = first; column <= last; ++column) {
+                TileColumn bits = columnAt(column);
+                if (!(bits & rows))
+                    continue;
+                const float x = static_cast<float>(static_cast<double>(column) * TILE_SIZE - _scroll);
+                // Whole runs, even the parts outside the box, so the shapes do not depend on the query
+                while (bits) {
+                    const int start = std::countr_zero(bits);
+                    const int length = std::countr_one(static_cast<TileColumn>(bits >> start));
+                    const TileColumn run = static_cast<TileColumn>(((std::uint64_t{1} << length) - 1) << start);
+                    bits &= ~run;
+                    if ((run & rows) && test(Position{x, start * TILE_SIZE}, TILE_SIZE, length * TILE_SIZE))
+                        return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Checks if a circle touches a solid tile
+         */
+        bool circleHits(const Position& center, float radius) const;
+
+        /**
+         * @brief Checks if a circle moving in a straight line touches a solid tile at some point of its motion
+         * @param motion The displacement of the circle relative to the tiles over the step
+         */
+        bool sweptCircleHits(const Position& start, const Velocity& motion, float radius) const;
+
+    private:
+        TileColumn columnAt(std::int64_t column) const;
+
+        std::array<TileChunk, LOADED_CHUNKS> _chunks{};
+        std::array<bool, LOADED_CHUNKS> _loaded{};
+        double _scroll = 0.0;
+    };
+}
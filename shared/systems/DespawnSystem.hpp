@@ -0,0 +1,68 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** DespawnSystem
+*/
+#pragma once
+#include "System.hpp"
+#include <vector>
+
+namespace rtype {
+    /**
+     * @class DespawnSystem
+     * @brief Removes the entities whose Lifetime ran out or which left their Bounds
+     *
+     * @details update counts down every Lifetime and checks every position against its Bounds,
+     * recording the entities to remove, then flush destroys them all at once. The handles of the
+     * removed entities are appended to a list given at construction, so the owner can announce the
+     * removals of the tick together.
+     */
+    class DespawnSystem : public ISystem {
+    public:
+        /**
+         * @param despawned Receives the handles of the removed entities, nullptr if nobody needs them.
+         * It must outlive the system and is never cleared by it.
+         */
+        explicit DespawnSystem(std::vector<EntityHandle>* despawned = nullptr) : despawned(despawned) {}
+
+        void update(EntityManager& manager, float dt) override {
+            expired.clear();
+            manager.view<Lifetime>().each([this, &manager, dt](EntityID entity, Lifetime& lifetime) {
+                lifetime.remaining -= dt;
+                if (lifetime.remaining <= 0.0f)
+                    expired.push_back(manager.getHandle(entity));
+            });
+            manager.view<const Position, const Bounds>().each([this, &manager](EntityID entity, const Position& pos, const Bounds& bounds) {
+                if (pos.x < bounds.minX || pos.x > bounds.maxX || pos.y < bounds.minY || pos.y > bounds.maxY)
+                    expired.push_back(manager.getHandle(entity));
+            });
+        }
+
+        /**
+         * @brief Declares the components read and written by update
+         */
+        SystemAccess access() const override {
+            return {signatureOf<Position, Bounds, Lifetime>(), signatureOf<Lifetime>(), false, false};
+        }
+
+        /**
+         * @brief Destroys the entities recorded during update
+         * @details An entity both expired and out of its bounds is only removed and reported once.
+         */
+        void flush(EntityManager& manager) override {
+            for (const EntityHandle& entity : expired) {
+                if (!manager.isValid(entity))
+                    continue;
+                manager.destroyEntity(entity.id);
+                if (despawned)
+                    despawned->push_back(entity);
+            }
+            expired.clear();
+        }
+
+    private:
+        std::vector<EntityHandle>* despawned;
+        std::vector<EntityHandle> expired; ///< Entities to remove this tick, reused across ticks
+    };
+}
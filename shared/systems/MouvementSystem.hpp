@@ -1,5 +1,11 @@
+#pragma once
 #include "System.hpp"
+#include "MovementKernels.hpp"
+#include "../physics/TileMap.hpp"
 #include <iostream>
+#include <algorithm>
+#include <utility>
+#include <vector>
 
 /**
  * @class MovementSystem
@@ -8,6 +14,11 @@
 namespace rtype {
     class MovementSystem : public ISystem {
     public:
+        /**
+         * @param tiles The level geometry blocking the entities, nullptr for none. It must outlive the system.
+         */
+        explicit MovementSystem(const physics::TileMap* tiles = nullptr) : tiles(tiles) {}
+
         /**
          * @brief Updates the position of entities based on their velocity and handles collisions (+ auto move of enemies with walls).
          *
@@ -17,75 +28,78 @@ namespace rtype {
          * @param dt The delta time since the last update.
         */
         void update(EntityManager& manager, float dt) override {
-            auto walls = manager.getEntitiesWithComponents<Wall>();
-
-            for (EntityID entity = 0; entity < MAX_ENTITIES; ++entity) {
-                if (manager.hasComponent<Position>(entity) && manager.hasComponent<Velocity>(entity)) {
-                    auto& pos = manager.getComponent<Position>(entity);
-                    auto& vel = manager.getComponent<Velocity>(entity);
-                    auto& proj = manager.getComponent<Projectile>(entity);
+            // Every entity of a chunk has the same components, so the branches are taken once per chunk
+            manager.view<Position, Velocity>().eachChunk([&](Signature signature, std::size_t count, const EntityID*,
+                Tick tick, Tick* const versions[], Position* positions, Velocity* velocities) {
+                // Projectiles leaving the map are removed by the DespawnSystem
+                if (signature & componentBit<Projectile>()) {
+                    kernels::integrate(positions, velocities, count, dt);
+                    std::fill_n(versions[0], count, tick);
+                    return;
+                }
+                const bool isEnemy = signature & componentBit<Enemy>();
+                // Static entities (health packs, idle players) must keep their Position version
+                previous.assign(positions, positions + count);
 
-                    if (manager.hasComponent<Projectile>(entity)) {
-                        pos.x += vel.dx * dt;
-                        pos.y += vel.dy * dt;
-                    } else if (!manager.hasComponent<Wall>(entity)) {
-                        bool hasCollided = false;
-                        for (EntityID wall : walls) {
-                            const auto& wallPos = manager.getComponent<Position>(wall);
-                            // Check collision for enemies
-                            if (manager.hasComponent<Enemy>(entity) && checkCollisionRect({pos.x + (vel.dx * dt), pos.y + (vel.dy * dt)}, 25.0f, wallPos, 120.0f, 80.0f)) { // Auto move enemies
-                                pos.y += 5 * dt;
-                            }
-                            // General collision detection (enemies and players)
-                            if (checkCollisionRect({pos.x + (vel.dx * dt), pos.y + (vel.dy * dt)}, 13.0f, wallPos, 20.0f, 60.0f)) {
-                                hasCollided = true;
-                                break;
-                            }
-                        }
-                        if (!hasCollided) {
-                            pos.x += vel.dx * dt;
-                            pos.y += vel.dy * dt;
-                        }
+                // Entities stopped by a wall keep their position, they are rare so they are restored after the kernel
+                blocked.clear();
+                if (tiles) {
+                    for (std::size_t row = 0; row < count; ++row) {
+                        if (collidesWithWalls(positions[row], velocities[row], isEnemy, dt))
+                            blocked.emplace_back(row, positions[row]);
                     }
+                }
+                kernels::integrate(positions, velocities, count, dt);
+                for (const auto& [row, pos] : blocked)
+                    positions[row] = pos;
 
-                    // Not leave the map for entities
-                    if (manager.hasComponent<Projectile>(entity)) {
-                        if (pos.x > 795)
-                            pos.x = 900;
-                        if (pos.y > 795)
-                            proj.isActive = false;
-                    } else {
-                        if (manager.hasComponent<Enemy>(entity))
-                            pos.x = std::clamp(pos.x, -20.0f, 795.0f); // Effect leave map but not real leave
-                        else
-                            pos.x = std::clamp(pos.x, 0.0f, 795.0f);
-                        pos.y = std::clamp(pos.y, 0.0f, 590.0f);
-                        if (manager.hasComponent<Enemy>(entity) && manager.getComponent<Position>(entity).x < -15) // Destroy enemies has finish the map
-                            manager.destroyEntity(entity);
-                    }
+                // Not leave the map for entities
+                if (isEnemy)
+                    kernels::clamp(positions, count, {-20.0f, 0.0f}, {795.0f, 590.0f}); // Effect leave map but not real leave
+                else
+                    kernels::clamp(positions, count, {0.0f, 0.0f}, {795.0f, 590.0f});
+                for (std::size_t row = 0; row < count; ++row) {
+                    if (positions[row].x != previous[row].x || positions[row].y != previous[row].y)
+                        versions[0][row] = tick;
                 }
-            }
+            });
         }
 
         /**
-         * @brief Checks if a circle and a rectangle are colliding.
-         *
-         * @param circlePos The position of the circle's center.
-         * @param radius The radius of the circle.
-         * @param rectPos The position of the top-left corner of the rectangle.
-         * @param rectWidth The width of the rectangle.
-         * @param rectHeight The height of the rectangle.
-         * @return True if the circle and rectangle are colliding, false otherwise.
+         * @brief Declares the components read and written by update
          */
-        bool checkCollisionRect(const Position& circlePos, float radius, const Position& rectPos, float rectWidth, float rectHeight) {
-            float closestX = std::max(rectPos.x, std::min(circlePos.x, rectPos.x + rectWidth));
-            float closestY = std::max(rectPos.y, std::min(circlePos.y, rectPos.y + rectHeight));
-
-            float dx = circlePos.x - closestX;
-            float dy = circlePos.y - closestY;
+        SystemAccess access() const override {
+            return {signatureOf<Position, Velocity>(), signatureOf<Position>(), false, false};
+        }
 
-            return (dx * dx + dy * dy) <= (radius * radius);
+        /**
+         * @brief Checks if an entity would hit the level geometry by moving this tick (+ auto move of enemies with walls).
+         *
+         * Entities already overlapping the geometry, which scrolls into them, are free to move out.
+         *
+         * @param pos The position of the entity, moved down when an enemy gets close to a wall.
+         * @param vel The velocity of the entity.
+         * @param isEnemy Whether the entity is an enemy.
+         * @param dt The delta time since the last update.
+         * @return True if the entity must not move this tick.
+         */
+        bool collidesWithWalls(Position& pos, const Velocity& vel, bool isEnemy, float dt) const {
+            const Position next{pos.x + (vel.dx * dt), pos.y + (vel.dy * dt)};
+            // Enemies slide down when they come near a wall, within the area right of it and below it
+            if (isEnemy && tiles->anyRun({next.x - 25.0f - ENEMY_PUSH_WIDTH, next.y - 25.0f - ENEMY_PUSH_HEIGHT, next.x + 25.0f, next.y + 25.0f},
+                [&next](const Position& wall, float width, float height) {
+                    return physics::circleHitsRect(next, 25.0f, wall, width + ENEMY_PUSH_WIDTH, height + ENEMY_PUSH_HEIGHT);
+                }))
+                pos.y += 5 * dt;
+            return tiles->circleHits({pos.x + (vel.dx * dt), pos.y + (vel.dy * dt)}, 13.0f) && !tiles->circleHits(pos, 13.0f);
         }
 
+    private:
+        static constexpr float ENEMY_PUSH_WIDTH = 100.0f; ///< How far right of a wall enemies are pushed down
+        static constexpr float ENEMY_PUSH_HEIGHT = 20.0f; ///< How far below a wall enemies are pushed down
+
+        const physics::TileMap* tiles; ///< Level geometry, nullptr for none
+        std::vector<Position> previous; ///< Positions of the current chunk before moving, to find the changed rows
+        std::vector<std::pair<std::size_t, Position>> blocked; ///< Rows of the current chunk stopped by a wall, with their position
     };
 }  // namespace rtype
@@ -0,0 +1,85 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** MovementKernels
+*/
+#pragma once
+#include "../ecs/Component.hpp"
+#include <algorithm>
+#include <cstddef>
+
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+    #include <immintrin.h>
+    #define RTYPE_KERNELS_SSE
+#endif
+
+/**
+ * @brief Vectorized kernels over packed Position and Velocity columns
+ *
+ * @details Archetype chunks store Position and Velocity as contiguous arrays of two floats, so a
+ * column is a flat float array (x0, y0, x1, y1, ...) the kernels process four or eight floats at
+ * a time. SSE2 is used on every x86-64 build, AVX when the compiler targets it (RTYPE_ENABLE_AVX2),
+ * other targets use the scalar loop. Every path computes the same results.
+ */
+namespace rtype::kernels {
+    static_assert(sizeof(Position) == 2 * sizeof(float), "Position must be two packed floats");
+    static_assert(sizeof(Velocity) == 2 * sizeof(float), "Velocity must be two packed floats");
+
+    /**
+     * @brief Moves every position by its velocity
+     * @param positions The positions to update
+     * @param velocities The velocities, one per position
+     * @param count The number of entities
+     * @param dt The delta time
+     */
+    inline void integrate(Position* positions, const Velocity* velocities, std::size_t count, float dt) {
+        float* pos = reinterpret_cast<float*>(positions);
+        const float* vel = reinterpret_cast<const float*>(velocities);
+        const std::size_t size = count * 2;
+        std::size_t i = 0;
+
+#if defined(__AVX__)
+        const __m256 step8 = _mm256_set1_ps(dt);
+        for (; i + 8 <= size; i += 8)
+            _mm256_storeu_ps(pos + i, _mm256_add_ps(_mm256_loadu_ps(pos + i), _mm256_mul_ps(_mm256_loadu_ps(vel + i), step8)));
+#endif
+#if defined(RTYPE_KERNELS_SSE)
+        const __m128 step4 = _mm_set1_ps(dt);
+        for (; i + 4 <= size; i += 4)
+            _mm_storeu_ps(pos + i, _mm_add_ps(_mm_loadu_ps(pos + i), _mm_mul_ps(_mm_loadu_ps(vel + i), step4)));
+#endif
+        for (; i < size; ++i)
+            pos[i] += vel[i] * dt;
+    }
+
+    /**
+     * @brief Clamps every position inside a rectangle
+     * @param positions The positions to clamp
+     * @param count The number of entities
+     * @param min The top-left corner of the rectangle
+     * @param max The bottom-right corner of the rectangle
+     */
+    inline void clamp(Position* positions, std::size_t count, Position min, Position max) {
+        float* pos = reinterpret_cast<float*>(positions);
+        const std::size_t size = count * 2;
+        std::size_t i = 0;
+
+#if defined(__AVX__)
+        const __m256 low8 = _mm256_setr_ps(min.x, min.y, min.x, min.y, min.x, min.y, min.x, min.y);
+        const __m256 high8 = _mm256_setr_ps(max.x, max.y, max.x, max.y, max.x, max.y, max.x, max.y);
+        for (; i + 8 <= size; i += 8)
+            _mm256_storeu_ps(pos + i, _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(pos + i), low8), high8));
+#endif
+#if defined(RTYPE_KERNELS_SSE)
+        const __m128 low4 = _mm_setr_ps(min.x, min.y, min.x, min.y);
+        const __m128 high4 = _mm_setr_ps(max.x, max.y, max.x, max.y);
+        for (; i + 4 <= size; i += 4)
+            _mm_storeu_ps(pos + i, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(pos + i), low4), high4));
+#endif
+        for (; i < size; i += 2) {
+            pos[i] = std::clamp(pos[i], min.x, max.x);
+            pos[i + 1] = std::clamp(pos[i + 1], min.y, max.y);
+        }
+    }
+}
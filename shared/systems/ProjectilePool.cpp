@@ -0,0 +1,96 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** ProjectilePool
+*/
+#include "ProjectilePool.hpp"
+#include "MovementKernels.hpp"
+
+namespace rtype {
+    ProjectilePool::ProjectilePool(EntityID firstId, std::size_t capacity, Bounds bounds)
+        : _firstId(firstId), _capacity(capacity), _bounds(bounds),
+          _positions(capacity), _velocities(capacity), _lifetimes(capacity), _damages(capacity), _radii(capacity),
+          _layers(capacity), _owners(capacity), _ultimates(capacity), _slots(capacity),
+          _rows(capacity, NO_ROW), _generations(capacity, 0) {
+        // Lowest slots first, so a room keeps its projectile IDs small
+        _freeSlots.reserve(capacity);
+        for (std::size_t slot = capacity; slot > 0; --slot)
+            _freeSlots.push_back(static_cast<uint32_t>(slot - 1));
+        _expired.reserve(capacity);
+        _spawned.reserve(capacity);
+    }
+
+    EntityHandle ProjectilePool::spawn(const ProjectileSpawn& spawn) {
+        if (_freeSlots.empty())
+            return {};
+        const uint32_t slot = _freeSlots.back();
+        _freeSlots.pop_back();
+        const std::size_t row = _size++;
+
+        _positions[row] = spawn.pos;
+        _velocities[row] = spawn.vel;
+        _lifetimes[row] = spawn.lifetime;
+        _damages[row] = spawn.damage;
+        _radii[row] = spawn.radius;
+        _layers[row] = spawn.layer;
+        _owners[row] = spawn.owner;
+        _ultimates[row] = spawn.isUltimate;
+        _slots[row] = slot;
+        _rows[slot] = static_cast<uint32_t>(row);
+
+        const EntityHandle handle{_firstId + slot, _generations[slot]};
+        _spawned.push_back(handle);
+        return handle;
+    }
+
+    bool ProjectilePool::retire(EntityHandle projectile) {
+        if (!isAlive(projectile))
+            return false;
+        removeRow(_rows[projectile.id - _firstId]);
+        return true;
+    }
+
+    void ProjectilePool::update(float dt) {
+        _expired.clear();
+        kernels::integrate(_positions.data(), _velocities.data(), _size, dt);
+        for (std::size_t row = 0; row < _size; ++row)
+            _lifetimes[row] -= dt;
+
+        // Backwards, so the row moved into a hole was already checked
+        for (std::size_t row = _size; row > 0; --row) {
+            const Position& pos = _positions[row - 1];
+            if (_lifetimes[row - 1] <= 0.0f || pos.x < _bounds.minX || pos.x > _bounds.maxX || pos.y < _bounds.minY || pos.y > _bounds.maxY) {
+                _expired.push_back(handleAt(row - 1));
+                removeRow(row - 1);
+            }
+        }
+    }
+
+    void ProjectilePool::clear() {
+        while (_size > 0)
+            removeRow(_size - 1);
+        _spawned.clear();
+        _expired.clear();
+    }
+
+    void ProjectilePool::removeRow(std::size_t row) {
+        const uint32_t slot = _slots[row];
+        const std::size_t last = --_size;
+        if (row != last) {
+            _positions[row] = _positions[last];
+            _velocities[row] = _velocities[last];
+            _lifetimes[row] = _lifetimes[last];
+            _damages[row] = _damages[last];
+            _radii[row] = _radii[last];
+            _layers[row] = _layers[last];
+            _owners[row] = _owners[last];
+            _ultimates[row] = _ultimates[last];
+            _slots[row] = _slots[last];
+            _rows[_slots[row]] = static_cast<uint32_t>(row);
+        }
+        _rows[slot] = NO_ROW;
+        _generations[slot]++;
+        _freeSlots.push_back(slot);
+    }
+}
@@ -0,0 +1,163 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** ProjectilePool
+*/
+#pragma once
+#include "../ecs/Component.hpp"
+#include "../ecs/Entity.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace rtype {
+    constexpr std::size_t DEFAULT_PROJECTILE_CAPACITY = 1 << 15; ///< Live projectiles per room
+    constexpr float DEFAULT_PROJECTILE_LIFETIME = 15.0f; ///< Seconds, longer than the slowest shot takes to cross the screen
+
+    /**
+     * @brief Everything a projectile is created with
+     */
+    struct ProjectileSpawn {
+        Position pos;
+        Velocity vel;
+        float damage = 1.0f;
+        float radius = 5.0f;
+        uint32_t layer = LAYER_PLAYER_SHOT; ///< One CollisionLayer bit
+        int owner = 0; ///< Projectile::lunchByType
+        bool isUltimate = false;
+        float lifetime = DEFAULT_PROJECTILE_LIFETIME; ///< Seconds before it expires
+    };
+
+    /**
+     * @class ProjectilePool
+     * @brief Fixed-capacity store of the projectiles of a room, beside the EntityManager
+     *
+     * @details Projectiles are many, short-lived and all alike, so they skip the archetypes: each
+     * attribute is a packed array of the live projectiles, allocated once at the full capacity.
+     * Spawning appends a row and retiring moves the last row into the hole, both O(1). update moves
+     * every projectile with the movement kernel and retires the ones that left the bounds or lived
+     * their lifetime, in one pass.
+     *
+     * Every slot of the pool owns one entity ID of a range reserved with EntityManager::reserveIds,
+     * and counts its own generations, so projectiles are named by EntityHandle like entities (in
+     * events, collision pairs and packets) without colliding with them. Row order changes when
+     * projectiles retire: keep handles, not row indices, across calls.
+     */
+    class ProjectilePool {
+    public:
+        /**
+         * @brief Constructs an empty pool
+         * @param firstId First entity ID of the range reserved for the pool, capacity IDs long
+         * @param capacity Maximum number of live projectiles
+         * @param bounds Area outside which projectiles expire, as for entities with a Bounds
+         */
+        explicit ProjectilePool(EntityID firstId, std::size_t capacity = DEFAULT_PROJECTILE_CAPACITY, Bounds bounds = {});
+
+        /**
+         * @brief Creates a projectile
+         * @return EntityHandle Handle on the projectile, an invalid handle if the pool is full
+         */
+        EntityHandle spawn(const ProjectileSpawn& spawn);
+
+        /**
+         * @brief Removes a live projectile
+         * @return bool False if the handle names no live projectile
+         */
+        bool retire(EntityHandle projectile);
+
+        /**
+         * @brief Moves every projectile by one step and retires the expired ones into expired()
+         * @param dt The delta time of the step
+         */
+        void update(float dt);
+
+        /**
+         * @brief Removes every projectile, handles taken before are all invalid after it
+         */
+        void clear();
+
+        /**
+         * @brief Checks if an entity ID belongs to the range of the pool, alive or not
+         */
+        bool owns(EntityID entity) const { return entity - _firstId < _capacity; }
+
+        /**
+         * @brief Checks if an entity ID names a live projectile
+         */
+        bool contains(EntityID entity) const { return owns(entity) && _rows[entity - _firstId] != NO_ROW; }
+
+        bool isAlive(EntityHandle projectile) const {
+            return contains(projectile.id) && _generations[projectile.id - _firstId] == projectile.generation;
+        }
+
+        /**
+         * @brief Gets the row of a live projectile
+         */
+        std::size_t rowOf(EntityID entity) const { return _rows[entity - _firstId]; }
+
+        /**
+         * @brief Gets the handle on the projectile of a row
+         */
+        EntityHandle handleAt(std::size_t row) const {
+            const std::size_t slot = _slots[row];
+            return {_firstId + slot, _generations[slot]};
+        }
+
+        std::size_t size() const { return _size; }
+        std::size_t capacity() const { return _capacity; }
+        bool empty() const { return _size == 0; }
+
+        const Position* positions() const { return _positions.data(); }
+        const Velocity* velocities() const { return _velocities.data(); }
+        const float* damages() const { return _damages.data(); }
+        const float* radii() const { return _radii.data(); }
+        const uint32_t* layers() const { return _layers.data(); }
+        const int* owners() const { return _owners.data(); }
+        const uint8_t* ultimates() const { return _ultimates.data(); }
+
+        /**
+         * @brief Gets the projectiles retired by the last update for leaving the bounds or expiring
+         */
+        const std::vector<EntityHandle>& expired() const { return _expired; }
+
+        /**
+         * @brief Gets the projectiles spawned since the last clearSpawned, some may be retired since
+         */
+        const std::vector<EntityHandle>& spawned() const { return _spawned; }
+
+        void clearSpawned() { _spawned.clear(); }
+
+    private:
+        static constexpr uint32_t NO_ROW = ~uint32_t{0};
+
+        /**
+         * @brief Fills a row with the last one and frees the slot of the row
+         */
+        void removeRow(std::size_t row);
+
+        EntityID _firstId;
+        std::size_t _capacity;
+        Bounds _bounds;
+        std::size_t _size = 0;
+
+        // Rows, packed
+        std::vector<Position> _positions;
+        std::vector<Velocity> _velocities;
+        std::vector<float> _lifetimes;
+        std::vector<float> _damages;
+        std::vector<float> _radii;
+        std::vector<uint32_t> _layers;
+        std::vector<int> _owners;
+        std::vector<uint8_t> _ultimates;
+        std::vector<uint32_t> _slots; ///< Slot of each row
+
+        // Slots, by entity ID minus _firstId
+        std::vector<uint32_t> _rows; ///< Row of each slot, NO_ROW when free
+        std::vector<EntityGeneration> _generations;
+        std::vector<uint32_t> _freeSlots;
+
+        std::vector<EntityHandle> _expired;
+        std::vector<EntityHandle> _spawned;
+    };
+}
@@ -0,0 +1,100 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** Scheduler
+*/
+#include "Scheduler.hpp"
+
+namespace rtype {
+    Scheduler::Scheduler(std::size_t threads) : _pool(threads) {}
+
+    bool Scheduler::conflicts(const SystemAccess& a, const SystemAccess& b) {
+        if (a.exclusive || b.exclusive)
+            return true;
+        // Main-thread systems share the window, the order of their draws matters
+        if (a.mainThread && b.mainThread)
+            return true;
+        return (a.writes & (b.reads | b.writes)) != 0 || (b.writes & a.reads) != 0;
+    }
+
+    void Scheduler::run(const std::vector<std::unique_ptr<ISystem>>& systems, EntityManager& manager, float dt) {
+        const std::size_t count = systems.size();
+        _nodes.resize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            Node& node = _nodes[i];
+            node.system = systems[i].get();
+            node.access = node.system->access();
+            node.remaining = 0;
+            node.dependents.clear();
+            for (std::size_t previous = 0; previous < i; ++previous) {
+                if (conflicts(_nodes[previous].access, node.access)) {
+                    _nodes[previous].dependents.push_back(i);
+                    node.remaining++;
+                }
+            }
+        }
+        _manager = &manager;
+        _dt = dt;
+        _done = 0;
+        _error = nullptr;
+        _mainQueue.clear();
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        for (std::size_t i = 0; i < count; ++i) {
+            if (_nodes[i].remaining == 0)
+                dispatch(i);
+        }
+        while (_done < count) {
+            if (_mainQueue.empty()) {
+                _progress.wait(lock);
+                continue;
+            }
+            std::size_t index = _mainQueue.back();
+            _mainQueue.pop_back();
+            lock.unlock();
+            execute(index);
+            complete(index);
+            lock.lock();
+        }
+        lock.unlock();
+
+        for (std::size_t i = 0; i < count; ++i)
+            _nodes[i].system->flush(manager);
+        if (_error)
+            std::rethrow_exception(_error);
+    }
+
+    void Scheduler::dispatch(std::size_t index) {
+        const SystemAccess& access = _nodes[index].access;
+        if (access.exclusive || access.mainThread || _pool.size() == 0) {
+            _mainQueue.push_back(index);
+            _progress.notify_one();
+            return;
+        }
+        _pool.submit([this, index] {
+            execute(index);
+            complete(index);
+        });
+    }
+
+    void Scheduler::complete(std::size_t index) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (std::size_t dependent : _nodes[index].dependents) {
+            if (--_nodes[dependent].remaining == 0)
+                dispatch(dependent);
+        }
+        _done++;
+        _progress.notify_one();
+    }
+
+    void Scheduler::execute(std::size_t index) {
+        try {
+            _nodes[index].system->update(*_manager, _dt);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_error)
+                _error = std::current_exception();
+        }
+    }
+}
@@ -0,0 +1,99 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** Scheduler
+*/
+#pragma once
+#include "System.hpp"
+#include "ThreadPool.hpp"
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rtype {
+    /**
+     * @class Scheduler
+     * @brief Runs the systems of a tick, in parallel when their declared accesses do not conflict
+     *
+     * @details Every tick, the Scheduler builds a dependency graph from the SystemAccess of each
+     * system: a system depends on every earlier system it conflicts with, so the result is the same
+     * as running the systems one by one in order. Systems whose dependencies are done are handed to
+     * a work-stealing ThreadPool, except exclusive and main-thread systems which run on the calling
+     * thread, in registration order. Once every system has run, flush() is called on each of them in
+     * order.
+     */
+    class Scheduler {
+    public:
+        /**
+         * @brief Creates a scheduler and its worker threads
+         * @param threads Number of worker threads, defaults to one less than the number of cores
+         */
+        explicit Scheduler(std::size_t threads = defaultThreadCount());
+
+        /**
+         * @brief Runs one tick of systems
+         * @details If systems throw, the remaining systems still run and the first exception is
+         * rethrown once the tick is over.
+         * @param systems The systems to run, in registration order
+         * @param manager The EntityManager passed to the systems
+         * @param dt The delta time passed to the systems
+         */
+        void run(const std::vector<std::unique_ptr<ISystem>>& systems, EntityManager& manager, float dt);
+
+        /**
+         * @brief Gets the number of worker threads
+         */
+        std::size_t threadCount() const { return _pool.size(); }
+
+        /**
+         * @brief Gets the default number of worker threads, one less than the number of cores
+         */
+        static std::size_t defaultThreadCount() {
+            unsigned int cores = std::thread::hardware_concurrency();
+            return cores > 1 ? cores - 1 : 0;
+        }
+
+    private:
+        /**
+         * @brief Checks if two systems must not run at the same time
+         */
+        static bool conflicts(const SystemAccess& a, const SystemAccess& b);
+
+        /**
+         * @brief Runs a system whose dependencies are done, on the pool or on the calling thread
+         * @details Must be called with the scheduler mutex held.
+         */
+        void dispatch(std::size_t index);
+
+        /**
+         * @brief Marks a system as done and dispatches the systems waiting only for it
+         */
+        void complete(std::size_t index);
+
+        /**
+         * @brief Runs a system, keeping the first exception thrown during the tick
+         */
+        void execute(std::size_t index);
+
+        struct Node {
+            ISystem* system = nullptr;
+            SystemAccess access;
+            std::size_t remaining = 0; ///< Dependencies not done yet
+            std::vector<std::size_t> dependents; ///< Systems waiting for this one
+        };
+
+        ThreadPool _pool;
+        std::vector<Node> _nodes; ///< Dependency graph of the current tick
+        std::vector<std::size_t> _mainQueue; ///< Ready systems that must run on the calling thread
+        std::size_t _done = 0;
+        std::mutex _mutex;
+        std::condition_variable _progress;
+        std::exception_ptr _error;
+        EntityManager* _manager = nullptr;
+        float _dt = 0;
+    };
+}
@@ -2,9 +2,38 @@
 #include "../ecs/EntityManager.hpp"
 
 namespace rtype {
+    /**
+     * @struct SystemAccess
+     * @brief Components a system touches during update, used by the Scheduler to run systems in parallel
+     *
+     * @details Two systems conflict if one writes a component the other reads or writes, if either
+     * is exclusive, or if both run on the main thread. Testing whether an entity has a component only reads its signature and does not
+     * need to be declared. Components declared as read must be accessed as const types
+     * (forEach<const Position>, getComponent<const Position>): mutable access stamps their version,
+     * which is a write.
+     */
+    struct SystemAccess {
+        Signature reads = 0; ///< Components whose data is read
+        Signature writes = 0; ///< Components whose data is modified
+        bool exclusive = false; ///< Makes structural changes during update, runs alone on the calling thread
+        bool mainThread = false; ///< Must run on the calling thread (e.g. draws to the window), after the earlier main-thread systems
+    };
+
     class ISystem {
     public:
         virtual ~ISystem() = default;
         virtual void update(EntityManager& manager, float dt) = 0;
+        /**
+         * @brief Declares the components touched by update
+         * @details Defaults to exclusive access, so a system that does not declare anything keeps
+         * running alone, in order, on the calling thread.
+         */
+        virtual SystemAccess access() const { return {~Signature{0}, ~Signature{0}, true, true}; }
+        /**
+         * @brief Applies the structural changes recorded during update
+         * @details Called by the Scheduler on the calling thread once every system of the tick has run,
+         * in registration order. Callers running a system without a Scheduler call it after update.
+         */
+        virtual void flush([[maybe_unused]] EntityManager& manager) {}
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,112 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** ThreadPool
+*/
+#include "ThreadPool.hpp"
+#include <algorithm>
+
+namespace rtype {
+    namespace {
+        thread_local const ThreadPool* currentPool = nullptr; ///< Pool owning the current thread, if any
+        thread_local std::size_t currentWorker = 0; ///< Index of the current thread in currentPool
+    }
+
+    ThreadPool::ThreadPool(std::size_t threads) {
+        for (std::size_t i = 0; i < threads; ++i)
+            _queues.push_back(std::make_unique<WorkerQueue>());
+        for (std::size_t i = 0; i < threads; ++i)
+            _threads.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(_sleepMutex);
+            _stop = true;
+        }
+        _wake.notify_all();
+        for (auto& thread : _threads)
+            thread.join();
+    }
+
+    void ThreadPool::submit(std::function<void()> task) {
+        if (_queues.empty()) {
+            task();
+            return;
+        }
+        std::size_t index = currentPool == this ? currentWorker : _next++ % _queues.size();
+        _pending++;
+        {
+            std::lock_guard<std::mutex> lock(_queues[index]->mutex);
+            _queues[index]->tasks.pushBack(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(_sleepMutex);
+        }
+        _wake.notify_one();
+    }
+
+    bool ThreadPool::popTask(std::size_t index, std::function<void()>& task) {
+        {
+            WorkerQueue& own = *_queues[index];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = own.tasks.popBack();
+                return true;
+            }
+        }
+        for (std::size_t i = 1; i < _queues.size(); ++i) {
+            WorkerQueue& victim = *_queues[(index + i) % _queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = victim.tasks.popFront();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void ThreadPool::TaskRing::pushBack(std::function<void()> task) {
+        if (_count == _slots.size()) {
+            std::vector<std::function<void()>> grown(std::max<std::size_t>(16, _slots.size() * 2));
+            for (std::size_t i = 0; i < _count; ++i)
+                grown[i] = std::move(_slots[(_head + i) % _slots.size()]);
+            _slots = std::move(grown);
+            _head = 0;
+        }
+        _slots[(_head + _count) % _slots.size()] = std::move(task);
+        _count++;
+    }
+
+    std::function<void()> ThreadPool::TaskRing::popBack() {
+        _count--;
+        return std::move(_slots[(_head + _count) % _slots.size()]);
+    }
+
+    std::function<void()> ThreadPool::TaskRing::popFront() {
+        std::function<void()> task = std::move(_slots[_head]);
+        _head = (_head + 1) % _slots.size();
+        _count--;
+        return task;
+    }
+
+    void ThreadPool::workerLoop(std::size_t index) {
+        currentPool = this;
+        currentWorker = index;
+        std::function<void()> task;
+
+        while (true) {
+            if (popTask(index, task)) {
+                _pending--;
+                task();
+                task = nullptr;
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(_sleepMutex);
+            _wake.wait(lock, [this] { return _stop || _pending > 0; });
+            if (_stop && _pending == 0)
+                return;
+        }
+    }
+}
@@ -0,0 +1,88 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** ThreadPool
+*/
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rtype {
+    /**
+     * @class ThreadPool
+     * @brief Fixed set of worker threads running tasks, idle workers steal from busy ones
+     *
+     * @details Every worker owns a task queue. A task submitted from a worker goes to that worker's
+     * queue, other tasks are spread round robin. A worker runs its own tasks newest first and, when
+     * its queue is empty, steals the oldest task of another worker before going to sleep.
+     * Tasks must not throw. Queues are ring buffers that keep their capacity, so a pool that has
+     * warmed up no longer allocates.
+     */
+    class ThreadPool {
+    public:
+        /**
+         * @brief Starts the workers
+         * @param threads Number of worker threads, may be 0
+         */
+        explicit ThreadPool(std::size_t threads);
+        /**
+         * @brief Runs the tasks still queued, then joins the workers
+         */
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * @brief Queues a task
+         * @details Without worker threads the task runs immediately on the calling thread.
+         * @param task The function to run on a worker
+         */
+        void submit(std::function<void()> task);
+
+        /**
+         * @brief Gets the number of worker threads
+         */
+        std::size_t size() const { return _threads.size(); }
+
+    private:
+        /**
+         * @brief Double-ended ring buffer of tasks, grows by doubling and never shrinks
+         */
+        class TaskRing {
+        public:
+            bool empty() const { return _count == 0; }
+            void pushBack(std::function<void()> task);
+            std::function<void()> popBack();
+            std::function<void()> popFront();
+
+        private:
+            std::vector<std::function<void()>> _slots;
+            std::size_t _head = 0; ///< Slot of the oldest task
+            std::size_t _count = 0;
+        };
+
+        struct WorkerQueue {
+            std::mutex mutex;
+            TaskRing tasks;
+        };
+
+        void workerLoop(std::size_t index);
+        bool popTask(std::size_t index, std::function<void()>& task);
+
+        std::vector<std::unique_ptr<WorkerQueue>> _queues;
+        std::vector<std::thread> _threads;
+        std::mutex _sleepMutex;
+        std::condition_variable _wake;
+        std::atomic<std::size_t> _pending{0}; ///< Tasks queued and not taken yet
+        std::atomic<std::size_t> _next{0}; ///< Round robin cursor for tasks submitted from outside
+        bool _stop = false;
+    };
+}
@@ -0,0 +1,56 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** TickClock
+*/
+#include "TickClock.hpp"
+#include <stdexcept>
+#include <thread>
+
+namespace rtype {
+    namespace {
+        constexpr auto SPIN_MARGIN = std::chrono::milliseconds(1); ///< Slept time left to yielding, to wake on time
+    }
+
+    TickClock::TickClock(int tickRate, int maxCatchUp) : _maxCatchUp(maxCatchUp) {
+        if (maxCatchUp <= 0)
+            throw std::invalid_argument("TickClock: the catch-up limit must be positive");
+        setTickRate(tickRate);
+        start();
+    }
+
+    void TickClock::setTickRate(int tickRate) {
+        if (tickRate <= 0)
+            throw std::invalid_argument("TickClock: the tick rate must be positive");
+        _tickRate = tickRate;
+        _step = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / tickRate));
+    }
+
+    void TickClock::start() {
+        _last = Clock::now();
+        _accumulator = Clock::duration{0};
+    }
+
+    int TickClock::consume() {
+        const Clock::time_point now = Clock::now();
+        _accumulator += now - _last;
+        _last = now;
+
+        int due = static_cast<int>(_accumulator / _step);
+        _accumulator -= due * _step;
+        if (due > _maxCatchUp) {
+            _dropped += due - _maxCatchUp;
+            due = _maxCatchUp;
+        }
+        return due;
+    }
+
+    void TickClock::sleepUntilNextTick() const {
+        const Clock::time_point deadline = _last + (_step - _accumulator);
+        if (deadline - Clock::now() > SPIN_MARGIN)
+            std::this_thread::sleep_until(deadline - SPIN_MARGIN);
+        while (Clock::now() < deadline)
+            std::this_thread::yield();
+    }
+}
@@ -0,0 +1,100 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** TickClock
+*/
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+namespace rtype {
+    constexpr int DEFAULT_TICK_RATE = 60; ///< Simulation ticks per second
+    constexpr int DEFAULT_MAX_CATCH_UP = 5; ///< Ticks run at most in one go after a stall
+
+    /**
+     * @class TickClock
+     * @brief Fixed-step clock: says how many simulation ticks are due and sleeps until the next one
+     *
+     * @details Real time is added to an accumulator and spent one fixed step at a time, so every
+     * tick simulates exactly stepSeconds() whatever the work or the sleep took. Deadlines follow
+     * each other from start() instead of from the end of the work, so the period does not drift.
+     * After a stall, at most maxCatchUp ticks are run at once and the rest of the lag is dropped
+     * (counted by droppedTicks) rather than sending the simulation into a spiral of late ticks.
+     * Tick numbers start at 1 and increase by one per tick run.
+     */
+    class TickClock {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief Constructs a clock
+         * @param tickRate The number of ticks per second
+         * @param maxCatchUp The number of ticks run at most by one call to update
+         * @throw std::invalid_argument if a value is not positive
+         */
+        explicit TickClock(int tickRate = DEFAULT_TICK_RATE, int maxCatchUp = DEFAULT_MAX_CATCH_UP);
+
+        /**
+         * @brief Changes the number of ticks per second, from the next tick on
+         * @throw std::invalid_argument if the rate is not positive
+         */
+        void setTickRate(int tickRate);
+
+        int tickRate() const { return _tickRate; }
+
+        /**
+         * @brief Gets the simulated time of one tick, in seconds
+         */
+        float stepSeconds() const { return 1.0f / static_cast<float>(_tickRate); }
+
+        /**
+         * @brief Starts counting time from now, forgetting any accumulated lag
+         */
+        void start();
+
+        /**
+         * @brief Runs the ticks due since the last call
+         * @param step Callable taking the tick number (std::uint32_t) and the step in seconds (float)
+         * @return int The number of ticks run
+         */
+        template<typename Function>
+        int update(Function&& step) {
+            const int due = consume();
+            for (int i = 0; i < due; ++i)
+                step(++_tick, stepSeconds());
+            return due;
+        }
+
+        /**
+         * @brief Blocks until the next tick is due
+         * @details Sleeps until just before the deadline, then yields until it is reached: plain
+         * sleeps overshoot by up to a scheduler quantum.
+         */
+        void sleepUntilNextTick() const;
+
+        /**
+         * @brief Gets the number of the last tick run, 0 before the first one
+         */
+        std::uint32_t tick() const { return _tick; }
+
+        /**
+         * @brief Gets the number of ticks skipped because the loop fell too far behind
+         */
+        std::uint64_t droppedTicks() const { return _dropped; }
+
+    private:
+        /**
+         * @brief Adds the time elapsed since the last call and takes the whole steps out of it
+         */
+        int consume();
+
+        int _tickRate;
+        int _maxCatchUp;
+        Clock::duration _step;
+        Clock::duration _accumulator{0};
+        Clock::time_point _last;
+        std::uint32_t _tick = 0;
+        std::uint64_t _dropped = 0;
+    };
+}
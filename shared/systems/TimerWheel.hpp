@@ -0,0 +1,230 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** TimerWheel
+*/
+#pragma once
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace rtype {
+    /**
+     * @brief Identifies a scheduled timer: its node index and the generation of the node
+     */
+    using TimerId = std::uint64_t;
+
+    /**
+     * @class TimerWheel
+     * @brief Hierarchical timing wheel counting in simulation ticks
+     *
+     * @details Timers hang in doubly linked lists, one per slot. The first level has a slot per
+     * tick for the next 256 ticks, each of the three others a slot per 64 slots of the level below,
+     * which covers 2^26 ticks (about 13 days at 60 ticks per second); later timers wait in the last
+     * level and are placed again each time they come round. When the first level wraps, the current
+     * slot of the next level is cascaded down, and so on. Scheduling and cancelling are O(1) and a
+     * tick only visits the timers that fire, plus the timers cascaded, each of which is moved at
+     * most once per level.
+     *
+     * Nodes are pooled and reused: once the pool has grown to the largest number of pending
+     * timers, scheduling does not allocate. Timers due on the same tick fire in no particular order.
+     * The callback may schedule and cancel timers, including timers due on the same tick.
+     * @tparam Payload What a timer carries to the callback, default-constructible and movable
+     */
+    template<typename Payload>
+    class TimerWheel {
+    public:
+        static constexpr int LEVELS = 4;
+        static constexpr int FIRST_BITS = 8;
+        static constexpr int LEVEL_BITS = 6;
+        static constexpr std::uint64_t MAX_DELAY = std::uint64_t{1} << (FIRST_BITS + LEVEL_BITS * (LEVELS - 1));
+
+        /**
+         * @brief Constructs an empty wheel
+         * @param now The current tick, the next one is the first that can fire
+         */
+        explicit TimerWheel(std::uint64_t now = 0) : _now(now) { _heads.fill(NONE); }
+
+        /**
+         * @brief Schedules a timer
+         * @param delay The number of ticks from now, 0 is handled as 1
+         * @param payload The value handed to the callback when it fires
+         * @return TimerId The identifier to cancel the timer
+         */
+        TimerId schedule(std::uint64_t delay, Payload payload) {
+            std::uint32_t index;
+            if (_free != NONE) {
+                index = _free;
+                _free = _nodes[index].next;
+            } else {
+                index = static_cast<std::uint32_t>(_nodes.size());
+                _nodes.emplace_back();
+            }
+            Node& node = _nodes[index];
+            node.expiry = _now + (delay == 0 ? 1 : delay);
+            node.payload = std::move(payload);
+            link(index, slotOf(node.expiry));
+            _size++;
+            return (static_cast<TimerId>(node.generation) << 32) | index;
+        }
+
+        /**
+         * @brief Cancels a pending timer
+         * @return bool False if the timer already fired or was cancelled
+         */
+        bool cancel(TimerId id) {
+            const auto index = static_cast<std::uint32_t>(id);
+            if (index >= _nodes.size() || _nodes[index].slot == NONE || _nodes[index].generation != static_cast<std::uint32_t>(id >> 32))
+                return false;
+            unlink(index);
+            release(index);
+            return true;
+        }
+
+        /**
+         * @brief Moves to the next tick and fires the timers due on it
+         * @param fire Callable taking a Payload&
+         * @return std::size_t The number of timers fired
+         */
+        template<typename Function>
+        std::size_t advance(Function&& fire) {
+            ++_now;
+            // Higher levels first: their timers may land in the lower slots cascaded next
+            for (int level = LEVELS - 1; level > 0; --level) {
+                const int shift = FIRST_BITS + LEVEL_BITS * (level - 1);
+                if ((_now & ((std::uint64_t{1} << shift) - 1)) == 0)
+                    cascade(levelSlot(level, _now >> shift));
+            }
+
+            // The due list is detached first so the callback can schedule into the same slot
+            std::size_t fired = 0;
+            moveList(static_cast<std::uint32_t>(_now & FIRST_MASK), FIRING);
+            while (_heads[FIRING] != NONE) {
+                const std::uint32_t index = _heads[FIRING];
+                unlink(index);
+                Payload payload = std::move(_nodes[index].payload);
+                release(index);
+                fired++;
+                fire(payload);
+            }
+            return fired;
+        }
+
+        /**
+         * @brief Moves tick by tick up to the given tick, firing the timers due on the way
+         * @return std::size_t The number of timers fired
+         */
+        template<typename Function>
+        std::size_t advanceTo(std::uint64_t tick, Function&& fire) {
+            std::size_t fired = 0;
+            while (_now < tick)
+                fired += advance(fire);
+            return fired;
+        }
+
+        /**
+         * @brief Gets the last tick advanced to
+         */
+        std::uint64_t now() const { return _now; }
+
+        /**
+         * @brief Gets the number of pending timers
+         */
+        std::size_t size() const { return _size; }
+
+        bool empty() const { return _size == 0; }
+
+    private:
+        static constexpr std::uint32_t NONE = ~std::uint32_t{0};
+        static constexpr std::uint64_t FIRST_MASK = (std::uint64_t{1} << FIRST_BITS) - 1;
+        static constexpr std::uint64_t LEVEL_MASK = (std::uint64_t{1} << LEVEL_BITS) - 1;
+        static constexpr std::uint32_t SLOTS = (1u << FIRST_BITS) + (LEVELS - 1) * (1u << LEVEL_BITS);
+        static constexpr std::uint32_t FIRING = SLOTS; ///< Extra list holding the timers being fired
+
+        struct Node {
+            std::uint64_t expiry = 0;
+            std::uint32_t prev = NONE;
+            std::uint32_t next = NONE;
+            std::uint32_t slot = NONE; ///< List holding the node, NONE while free
+            std::uint32_t generation = 0;
+            Payload payload{};
+        };
+
+        static std::uint32_t levelSlot(int level, std::uint64_t shifted) {
+            return (1u << FIRST_BITS) + static_cast<std::uint32_t>(level - 1) * (1u << LEVEL_BITS) + static_cast<std::uint32_t>(shifted & LEVEL_MASK);
+        }
+
+        /**
+         * @brief Gets the slot of the smallest level whose span covers the expiry
+         */
+        std::uint32_t slotOf(std::uint64_t expiry) const {
+            std::uint64_t delta = expiry - _now;
+            if (delta < (std::uint64_t{1} << FIRST_BITS))
+                return static_cast<std::uint32_t>(expiry & FIRST_MASK);
+            if (delta >= MAX_DELAY) {
+                // Parked as far as possible, placed again when cascaded
+                expiry = _now + MAX_DELAY - 1;
+                delta = MAX_DELAY - 1;
+            }
+            int level = 1;
+            while (delta >= (std::uint64_t{1} << (FIRST_BITS + LEVEL_BITS * level)))
+                ++level;
+            return levelSlot(level, expiry >> (FIRST_BITS + LEVEL_BITS * (level - 1)));
+        }
+
+        void link(std::uint32_t index, std::uint32_t slot) {
+            Node& node = _nodes[index];
+            node.slot = slot;
+            node.prev = NONE;
+            node.next = _heads[slot];
+            if (node.next != NONE)
+                _nodes[node.next].prev = index;
+            _heads[slot] = index;
+        }
+
+        void unlink(std::uint32_t index) {
+            Node& node = _nodes[index];
+            if (node.prev != NONE)
+                _nodes[node.prev].next = node.next;
+            else
+                _heads[node.slot] = node.next;
+            if (node.next != NONE)
+                _nodes[node.next].prev = node.prev;
+            node.slot = NONE;
+        }
+
+        void release(std::uint32_t index) {
+            Node& node = _nodes[index];
+            node.payload = Payload{};
+            node.generation++;
+            node.next = _free;
+            _free = index;
+            _size--;
+        }
+
+        void moveList(std::uint32_t from, std::uint32_t to) {
+            _heads[to] = _heads[from];
+            _heads[from] = NONE;
+            for (std::uint32_t index = _heads[to]; index != NONE; index = _nodes[index].next)
+                _nodes[index].slot = to;
+        }
+
+        void cascade(std::uint32_t slot) {
+            std::uint32_t index = _heads[slot];
+            _heads[slot] = NONE;
+            while (index != NONE) {
+                const std::uint32_t next = _nodes[index].next;
+                link(index, slotOf(_nodes[index].expiry));
+                index = next;
+            }
+        }
+
+        std::vector<Node> _nodes;
+        std::array<std::uint32_t, SLOTS + 1> _heads;
+        std::uint32_t _free = NONE;
+        std::uint64_t _now;
+        std::size_t _size = 0;
+    };
+}
@@ -0,0 +1,89 @@
+/*
+** EPITECH PROJECT, 2025
+** R_typed
+** File description:
+** WeaponSystem
+*/
+#pragma once
+#include "System.hpp"
+#include "ProjectilePool.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace rtype {
+    /**
+     * @class WeaponSystem
+     * @brief Fires the weapons of every entity in one pass
+     *
+     * @details update counts down the cooldowns of every Weapon and records the shots of the
+     * weapons whose trigger is pulled and ready, then flush spawns all the projectiles of the tick
+     * into the ProjectilePool at once. Cooldowns are simulated time: nothing reads the wall clock,
+     * and the cost is one row per armed entity plus one per projectile.
+     */
+    class WeaponSystem : public ISystem {
+    public:
+        /**
+         * @param projectiles The pool receiving the projectiles, it must outlive the system
+         */
+        explicit WeaponSystem(ProjectilePool& projectiles) : projectiles(projectiles) {}
+
+        void update(EntityManager& manager, float dt) override {
+            shots.clear();
+            manager.view<Weapon, const Position>().each([this, dt](EntityID, Weapon& weapon, const Position& pos) {
+                weapon.readyIn = std::max(weapon.readyIn - dt, 0.0f);
+                weapon.ultimateReadyIn = std::max(weapon.ultimateReadyIn - dt, 0.0f);
+                if (weapon.trigger && weapon.readyIn <= 0.0f) {
+                    weapon.readyIn = weapon.cooldown;
+                    fire(weapon, weapon.shot, pos);
+                }
+                if (weapon.ultimateTrigger && weapon.ultimateReadyIn <= 0.0f) {
+                    weapon.ultimateReadyIn = weapon.ultimateCooldown;
+                    fire(weapon, weapon.ultimate, pos);
+                }
+                if (!weapon.automatic) {
+                    weapon.trigger = false;
+                    weapon.ultimateTrigger = false;
+                }
+            });
+        }
+
+        /**
+         * @brief Declares the components read and written by update
+         */
+        SystemAccess access() const override {
+            return {signatureOf<Position, Weapon>(), signatureOf<Weapon>(), false, false};
+        }
+
+        /**
+         * @brief Spawns the projectiles of the shots fired during update
+         * @details Shots past the capacity of the pool are dropped.
+         */
+        void flush([[maybe_unused]] EntityManager& manager) override {
+            for (const ProjectileSpawn& shot : shots)
+                projectiles.spawn(shot);
+            shots.clear();
+        }
+
+    private:
+
+        /**
+         * @brief Records the projectiles of one shot, fanned out around the horizontal
+         */
+        void fire(const Weapon& weapon, const ProjectilePrefab& prefab, const Position& pos) {
+            const float first = static_cast<float>(prefab.count - 1) * prefab.spread / 2.0f;
+            for (int i = 0; i < prefab.count; ++i) {
+                ProjectileSpawn shot;
+                shot.pos = pos;
+                shot.vel = {prefab.speed, first - static_cast<float>(i) * prefab.spread};
+                shot.damage = prefab.damage;
+                shot.layer = weapon.layer;
+                shot.owner = weapon.owner;
+                shot.isUltimate = prefab.isUltimate;
+                shots.push_back(shot);
+            }
+        }
+
+        ProjectilePool& projectiles;
+        std::vector<ProjectileSpawn> shots; ///< Projectiles of the current tick, reused across ticks
+    };
+}